@@ -17,30 +17,40 @@ int main()
     SetTraceLogLevel(LOG_ALL); // Enable all logs
     TRACELOGD("*** Started main ***");
     SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT);
+
+    // fonts are built on a worker while the window and GL context are created
+    rlImGuiBeginSetupAsync(true);
+
     InitWindow(screenWidth, screenHeight, "Trayimg!");
     SetWindowPosition(25, 50);
 
     SetTargetFPS(60);
 
-    rlImGuiSetup(true);
+    rlImGuiEndSetupAsync();
 
     float size = 400.0f;
     while (!WindowShouldClose()) {
 
         // CheckResize();
 
-        BeginDrawing();
+        // build the UI first, so unchanged frames are not drawn or presented at all
         rlImGuiBegin();
 
-        ClearBackground(RAYWHITE);
         ImGui::Begin("ImGui window");
         ImGui::SeparatorText("Rectangle");
         ImGui::DragFloat("size", &size, 1.0f, 100.0f, 800.0f);
         ImGui::End();
 
-        DrawRectangle(100, 100, size, size, RED);
-        rlImGuiEnd();
-        EndDrawing();
+        // the scene only depends on the UI, so an unchanged UI means an unchanged frame
+        if (rlImGuiPrepareFrame()) {
+            BeginDrawing();
+            ClearBackground(RAYWHITE);
+            DrawRectangle(100, 100, size, size, RED);
+            rlImGuiEnd();
+            EndDrawing();
+        } else {
+            rlImGuiSkipFrame();
+        }
     }
     rlImGuiShutdown();
 
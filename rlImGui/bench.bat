@@ -0,0 +1,14 @@
+@echo off
+rem builds and runs the backend benchmark, run build.bat first to build librlImGui.a
+rem usage: bench.bat [frames per scene] [output.json] [session.rlir]
+rem        bench.bat --record session.rlir
+
+set /p=--- Compiling ui_bench...<nul
+@echo on
+g++ ./bench/ui_bench.cpp -O2 -DNDEBUG -DPLATFORM_DESKTOP -DGRAPHICS_API_OPENGL_33 -I../raylib/src -I./src/ -I./imgui -L./src -L../raylib/src -lrlImGui -lraylib -lopengl32 -lgdi32 -lwinmm -m64 -std=c++17 -o ./bench/ui_bench.exe
+@echo off
+@echo.
+
+set /p=--- Running ui_bench...<nul
+@echo on
+bench\ui_bench.exe %*
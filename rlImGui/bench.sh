@@ -0,0 +1,14 @@
+# builds and runs the backend benchmark, run build.sh first to build librlImGui.a
+# usage: bench.sh [frames per scene] [output.json] [session.rlir]
+#        bench.sh --record session.rlir
+
+echo "--- Compiling ui_bench..."
+g++ ./bench/ui_bench.cpp -O2 -DNDEBUG -DPLATFORM_DESKTOP -DGRAPHICS_API_OPENGL_33 -I../raylib/src -I./src/ -I./imgui -L./src -L../raylib/src -lrlImGui -lraylib -lGL -lm -lpthread -ldl -lrt -lX11 -m64 -std=c++17 -o ./bench/ui_bench || exit 1
+
+echo "--- Running ui_bench..."
+# without a display, run on a virtual X server with Mesa's software rasterizer
+if [ -z "$DISPLAY" ] && command -v xvfb-run > /dev/null; then
+    LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a -s "-screen 0 1280x800x24" ./bench/ui_bench "$@"
+else
+    ./bench/ui_bench "$@"
+fi
@@ -0,0 +1,23 @@
+@echo off
+
+set /p=--- Compiling convert_bench...<nul
+@echo on
+g++ ./convert_bench.cpp -O2 -DNDEBUG -I../src -I../imgui -m64 -std=c++17 -o ./convert_bench.exe
+@echo off
+@echo.
+
+set /p=--- Running convert_bench...<nul
+@echo on
+convert_bench.exe
+@echo off
+@echo.
+
+set /p=--- Compiling keymap_bench...<nul
+@echo on
+g++ ./keymap_bench.cpp ../imgui/imgui.cpp ../imgui/imgui_demo.cpp ../imgui/imgui_draw.cpp ../imgui/imgui_tables.cpp ../imgui/imgui_widgets.cpp -O2 -DNDEBUG -I../src -I../imgui -I../../raylib/src -m64 -std=c++17 -o ./keymap_bench.exe
+@echo off
+@echo.
+
+set /p=--- Running keymap_bench...<nul
+@echo on
+keymap_bench.exe
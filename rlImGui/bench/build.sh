@@ -0,0 +1,11 @@
+echo "--- Compiling convert_bench..."
+g++ ./convert_bench.cpp -O2 -DNDEBUG -I../src -I../imgui -m64 -std=c++17 -o ./convert_bench
+
+echo "--- Running convert_bench..."
+./convert_bench
+
+echo "--- Compiling keymap_bench..."
+g++ ./keymap_bench.cpp ../imgui/imgui.cpp ../imgui/imgui_demo.cpp ../imgui/imgui_draw.cpp ../imgui/imgui_tables.cpp ../imgui/imgui_widgets.cpp -O2 -DNDEBUG -I../src -I../imgui -I../../raylib/src -m64 -std=c++17 -o ./keymap_bench
+
+echo "--- Running keymap_bench..."
+./keymap_bench
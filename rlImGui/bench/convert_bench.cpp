@@ -0,0 +1,174 @@
+/**********************************************************************************************
+*
+*   rlImGui * vertex conversion microbenchmark
+*
+*   Compares the bulk de-index kernels from rlImGuiConvert.h with the per-vertex path
+*   rlImGui uses for immediate mode rendering (ImGuiTriangleVert), at 100K and 1M vertices.
+*
+*   LICENSE: ZLIB
+*
+**********************************************************************************************/
+
+#include "rlImGuiConvert.h"
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+// stands in for rlgl's render batch, which the per-vertex path fills one rlColor4ub/rlTexCoord2f/rlVertex2f call at a time
+struct ImmediateBatch
+{
+    std::vector<float> Vertices;
+    std::vector<float> TexCoords;
+    std::vector<unsigned char> Colors;
+    int Counter = 0;
+
+    unsigned char Color[4] = { 0 };
+    float TexCoord[2] = { 0 };
+};
+
+static ImmediateBatch Batch;
+
+// same work as the rlgl functions, kept out of line as they live in raylib
+BENCH_NOINLINE static void Color4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+    Batch.Color[0] = r; Batch.Color[1] = g; Batch.Color[2] = b; Batch.Color[3] = a;
+}
+
+BENCH_NOINLINE static void TexCoord2f(float x, float y)
+{
+    Batch.TexCoord[0] = x; Batch.TexCoord[1] = y;
+}
+
+BENCH_NOINLINE static void Vertex2f(float x, float y)
+{
+    int i = Batch.Counter++;
+    Batch.Vertices[i * 3 + 0] = x;
+    Batch.Vertices[i * 3 + 1] = y;
+    Batch.Vertices[i * 3 + 2] = 0;
+    Batch.TexCoords[i * 2 + 0] = Batch.TexCoord[0];
+    Batch.TexCoords[i * 2 + 1] = Batch.TexCoord[1];
+    memcpy(&Batch.Colors[i * 4], Batch.Color, 4);
+}
+
+struct BenchColor { unsigned char r, g, b, a; };
+
+// mirrors ImGuiTriangleVert in rlImGui.cpp
+static void TriangleVert(const ImDrawVert& idx_vert)
+{
+    const BenchColor* c = reinterpret_cast<const BenchColor*>(&idx_vert.col);
+    Color4ub(c->r, c->g, c->b, c->a);
+    TexCoord2f(idx_vert.uv.x, idx_vert.uv.y);
+    Vertex2f(idx_vert.pos.x, idx_vert.pos.y);
+}
+
+template<typename Index>
+static void PerVertex(ImDrawVert*, const ImDrawVert* vertices, const Index* indices, unsigned int count)
+{
+    Batch.Counter = 0;
+    for (unsigned int i = 0; i < count; ++i)
+        TriangleVert(vertices[indices[i]]);
+}
+
+template<typename Index>
+static double BestTime(rlImGuiConvert::DeindexKernel<Index> kernel, ImDrawVert* out, const std::vector<ImDrawVert>& vertices, const std::vector<Index>& indices, int repeats)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        kernel(out, vertices.data(), indices.data(), (unsigned int)indices.size());
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        if (elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+template<typename Index>
+static bool RunSize(unsigned int vertexCount, const char* indexName)
+{
+    // ImGui geometry is mostly quads, 4 vertices and 6 indices each
+    unsigned int quads = vertexCount / 6;
+    std::vector<ImDrawVert> vertices(quads * 4);
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        vertices[i].pos = ImVec2(float(i % 1920), float(i / 1920));
+        vertices[i].uv = ImVec2(float(i & 255) / 256.0f, float((i >> 8) & 255) / 256.0f);
+        vertices[i].col = 0xFF000000u | (unsigned int)(i * 2654435761u >> 8);
+    }
+
+    // 16 bit draw lists restart their indices every 64K vertices
+    unsigned int indexLimit = sizeof(Index) == 2 ? 65536 : 0xFFFFFFFFu;
+    std::vector<Index> indices;
+    indices.reserve(quads * 6);
+    for (unsigned int q = 0; q < quads; ++q)
+    {
+        unsigned int base = (q * 4) % (indexLimit - indexLimit % 4);
+        const unsigned int pattern[6] = { 0, 1, 2, 0, 2, 3 };
+        for (unsigned int p : pattern)
+            indices.push_back(Index(base + p));
+    }
+
+    Batch.Vertices.resize(indices.size() * 3);
+    Batch.TexCoords.resize(indices.size() * 2);
+    Batch.Colors.resize(indices.size() * 4);
+
+    std::vector<ImDrawVert> reference(indices.size());
+    std::vector<ImDrawVert> out(indices.size());
+    rlImGuiConvert::DeindexScalar(reference.data(), vertices.data(), indices.data(), (unsigned int)indices.size());
+
+    int repeats = vertexCount >= 1000000 ? 20 : 100;
+
+    struct Kernel { const char* Name; rlImGuiConvert::DeindexKernel<Index> Function; };
+    std::vector<Kernel> kernels = { { "per-vertex", PerVertex<Index> }, { "scalar", rlImGuiConvert::DeindexScalar<Index> } };
+#ifdef RLIMGUI_CONVERT_SSE2
+    kernels.push_back({ "SSE2", rlImGuiConvert::DeindexSSE2<Index> });
+#endif
+#ifdef RLIMGUI_CONVERT_AVX2
+    if (rlImGuiConvert::CPUHasAVX2())
+        kernels.push_back({ "AVX2", rlImGuiConvert::DeindexAVX2<Index> });
+#endif
+
+    double perVertexTime = 0;
+    bool ok = true;
+    for (const Kernel& kernel : kernels)
+    {
+        std::fill(out.begin(), out.end(), ImDrawVert());
+        double seconds = BestTime(kernel.Function, out.data(), vertices, indices, repeats);
+        if (kernel.Function == PerVertex<Index>)
+            perVertexTime = seconds;
+
+        bool matches = kernel.Function == PerVertex<Index> || memcmp(out.data(), reference.data(), out.size() * sizeof(ImDrawVert)) == 0;
+        ok = ok && matches;
+
+        printf("%9u  %-6s  %-10s  %8.3f ms  %6.2f ns/vertex  %5.2fx%s\n",
+            (unsigned int)indices.size(), indexName, kernel.Name, seconds * 1000.0, seconds * 1e9 / indices.size(),
+            perVertexTime / seconds, matches ? "" : "  MISMATCH");
+    }
+
+    return ok;
+}
+
+int main()
+{
+    printf("selected kernel: %s\n\n", rlImGuiConvert::GetDeindexKernelName<ImDrawIdx>(rlImGuiConvert::GetDeindexKernel<ImDrawIdx>()));
+    printf("%9s  %-6s  %-10s  %11s  %16s  %6s\n", "vertices", "index", "kernel", "best", "", "speedup");
+
+    bool ok = true;
+    for (unsigned int vertexCount : { 100000u, 1000000u })
+    {
+        ok = RunSize<unsigned short>(vertexCount, "16 bit") && ok;
+        ok = RunSize<unsigned int>(vertexCount, "32 bit") && ok;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,238 @@
+/**********************************************************************************************
+*
+*   rlImGui * keyboard translation microbenchmark
+*
+*   Compares the per-frame cost of the old std::map keymap walk (IsKeyReleased + IsKeyPressed for
+*   every mapped key) with rlImGuiKeymap::TranslateKeyEvents, polling and reading the key queue,
+*   over scripted idle, typing and key holding input.
+*
+*   LICENSE: ZLIB
+*
+**********************************************************************************************/
+
+#include "rlImGuiKeymap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+// raylib's keyboard state and queries, same logic as rcore.c and kept out of line as they live in raylib
+struct BenchKeyboard
+{
+    static constexpr int MaxKeys = 512;
+    static constexpr int MaxQueue = 16;
+
+    static char Current[MaxKeys];
+    static char Previous[MaxKeys];
+    static int Queue[MaxQueue];
+    static int QueueCount;
+
+    BENCH_NOINLINE static bool IsKeyPressed(int key)
+    {
+        return key > 0 && key < MaxKeys && Previous[key] == 0 && Current[key] == 1;
+    }
+
+    BENCH_NOINLINE static bool IsKeyReleased(int key)
+    {
+        return key > 0 && key < MaxKeys && Previous[key] == 1 && Current[key] == 0;
+    }
+
+    BENCH_NOINLINE static bool IsKeyUp(int key)
+    {
+        return key > 0 && key < MaxKeys && Current[key] == 0;
+    }
+
+    BENCH_NOINLINE static int GetKeyPressed(void)
+    {
+        if (QueueCount == 0)
+            return 0;
+
+        int key = Queue[0];
+        for (int i = 0; i < QueueCount - 1; i++)
+            Queue[i] = Queue[i + 1];
+        QueueCount--;
+        return key;
+    }
+
+    // what PollInputEvents and the GLFW key callback do between two frames
+    static void NextFrame(void)
+    {
+        memcpy(Previous, Current, sizeof(Current));
+        QueueCount = 0;
+    }
+
+    static void SetKey(int key, bool down)
+    {
+        Current[key] = down ? 1 : 0;
+        if (down && QueueCount < MaxQueue)
+            Queue[QueueCount++] = key;
+    }
+
+    static void Reset(void)
+    {
+        memset(Current, 0, sizeof(Current));
+        memset(Previous, 0, sizeof(Previous));
+        QueueCount = 0;
+    }
+};
+
+char BenchKeyboard::Current[MaxKeys];
+char BenchKeyboard::Previous[MaxKeys];
+int BenchKeyboard::Queue[MaxQueue];
+int BenchKeyboard::QueueCount = 0;
+
+// stands in for io.AddKeyEvent, and checks every path sends the same events
+struct EventSink
+{
+    long long Count = 0;
+    long long Checksum = 0;
+
+    void Add(ImGuiKey key, bool down)
+    {
+        Count++;
+        Checksum += (long long)key * (down ? 3 : 7);
+    }
+};
+
+typedef void (*Script)(int frame);
+
+static void IdleScript(int)
+{
+}
+
+// a key stroke every 4 frames, held for 2, with shift on every 8th
+static void TypingScript(int frame)
+{
+    static const KeyboardKey letters[] = { KEY_H, KEY_E, KEY_L, KEY_O, KEY_SPACE, KEY_W, KEY_R, KEY_D };
+    KeyboardKey key = letters[(frame / 4) % 8];
+
+    if (frame % 4 == 0)
+    {
+        if ((frame / 4) % 8 == 0)
+            BenchKeyboard::SetKey(KEY_LEFT_SHIFT, true);
+        BenchKeyboard::SetKey(key, true);
+    }
+    else if (frame % 4 == 2)
+    {
+        BenchKeyboard::SetKey(key, false);
+        BenchKeyboard::SetKey(KEY_LEFT_SHIFT, false);
+    }
+}
+
+// an arrow key held down for the whole run
+static void HoldingScript(int frame)
+{
+    if (frame == 0)
+        BenchKeyboard::SetKey(KEY_DOWN, true);
+}
+
+static std::map<KeyboardKey, ImGuiKey> MapKeymap;
+
+enum class Path { None, MapWalk, TablePoll, KeyQueue };
+
+static double Run(Path path, Script script, int frames, EventSink& sink)
+{
+    BenchKeyboard::Reset();
+    ImVector<int> heldKeys;
+    auto add = [&sink](ImGuiKey key, bool down) { sink.Add(key, down); };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        BenchKeyboard::NextFrame();
+        script(frame);
+
+        switch (path)
+        {
+        case Path::None:
+            break;
+
+        case Path::MapWalk:
+            // the loop rlImGui used before the constant table
+            for (const auto keyItr : MapKeymap)
+            {
+                if (BenchKeyboard::IsKeyReleased(keyItr.first))
+                    add(keyItr.second, false);
+                else if (BenchKeyboard::IsKeyPressed(keyItr.first))
+                    add(keyItr.second, true);
+            }
+            break;
+
+        case Path::TablePoll:
+            rlImGuiKeymap::TranslateKeyEvents<BenchKeyboard>(heldKeys, false, add);
+            break;
+
+        case Path::KeyQueue:
+            rlImGuiKeymap::TranslateKeyEvents<BenchKeyboard>(heldKeys, true, add);
+            break;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    return elapsed.count();
+}
+
+static double BestRun(Path path, Script script, int frames, EventSink& sink)
+{
+    double best = 1e30;
+    for (int repeat = 0; repeat < 5; repeat++)
+    {
+        sink = EventSink();
+        double seconds = Run(path, script, frames, sink);
+        if (seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+
+int main()
+{
+    for (const rlImGuiKeymap::KeyMapping& mapping : rlImGuiKeymap::Mappings)
+        MapKeymap[mapping.RaylibKey] = mapping.Key;
+
+    constexpr int frames = 1000000;
+
+    struct Scenario { const char* Name; Script Function; };
+    const Scenario scenarios[] = { { "idle", IdleScript }, { "typing", TypingScript }, { "holding", HoldingScript } };
+
+    struct Method { const char* Name; Path Function; };
+    const Method methods[] = { { "map walk", Path::MapWalk }, { "table poll", Path::TablePoll }, { "key queue", Path::KeyQueue } };
+
+    printf("%d mapped keys, %d frames per run\n\n", int(sizeof(rlImGuiKeymap::Mappings) / sizeof(rlImGuiKeymap::Mappings[0])), frames);
+    printf("%-8s  %-10s  %10s  %8s  %8s\n", "input", "path", "ns/frame", "speedup", "events");
+
+    bool ok = true;
+    for (const Scenario& scenario : scenarios)
+    {
+        // the scripted input alone, subtracted so only the translation is compared
+        EventSink sink;
+        double baseline = BestRun(Path::None, scenario.Function, frames, sink);
+
+        double mapTime = 0;
+        EventSink reference;
+        for (const Method& method : methods)
+        {
+            double seconds = BestRun(method.Function, scenario.Function, frames, sink) - baseline;
+            if (method.Function == Path::MapWalk)
+            {
+                mapTime = seconds;
+                reference = sink;
+            }
+
+            bool matches = sink.Count == reference.Count && sink.Checksum == reference.Checksum;
+            ok = ok && matches;
+
+            printf("%-8s  %-10s  %10.2f  %7.1fx  %8lld%s\n", scenario.Name, method.Name, seconds * 1e9 / frames,
+                mapTime / (seconds > 0 ? seconds : 1e-12), sink.Count, matches ? "" : "  MISMATCH");
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+/**********************************************************************************************
+*
+*   rlImGui * backend benchmark
+*
+*   Runs scripted UI scenes through rlImGuiBegin/rlImGuiEnd into an offscreen render texture
+*   and prints frame time percentiles and backend counters as JSON.
+*
+*   The window is created hidden, so on machines without a display or GPU run it under a virtual
+*   X server with Mesa's software rasterizer (llvmpipe), see ../bench.sh:
+*       LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a ./ui_bench
+*
+*   usage: ui_bench [frames per scene] [output.json] [session.rlir]
+*          ui_bench --record session.rlir
+*
+*   --record opens a visible window with the demo window and records the input until it is closed.
+*   Given a recorded session, the bench replays it first, on the fresh context it was recorded from,
+*   with the recorded frame times, so every run of it draws the same frames.
+*
+*   LICENSE: ZLIB
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+
+#include "imgui.h"
+#include "rlImGui.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef void (*SceneFunc)(int frame);
+
+struct Scene
+{
+    const char* Name;
+    SceneFunc Draw;
+};
+
+static void DemoScene(int frame)
+{
+    // scroll through the demo window, as a user reading it would
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(600, 700), ImGuiCond_Always);
+    ImGui::SetNextWindowScroll(ImVec2(0, float((frame * 7) % 2000)));
+    ImGui::ShowDemoWindow(nullptr);
+}
+
+// the UI of recorded sessions, the demo window in its default place
+static void SessionScene(int)
+{
+    ImGui::ShowDemoWindow(nullptr);
+}
+
+static int RecordSession(const char* fileName)
+{
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+    InitWindow(1280, 800, "rlImGui bench recording");
+    SetTargetFPS(60);
+    rlImGuiSetup(true);
+    ImGui::GetIO().IniFilename = nullptr;
+
+    rlImGuiStartRecording(fileName);
+    while (!WindowShouldClose())
+    {
+        BeginDrawing();
+        ClearBackground(DARKGRAY);
+
+        rlImGuiBegin();
+        SessionScene(0);
+        rlImGuiEnd();
+
+        EndDrawing();
+    }
+    bool saved = rlImGuiStopRecording();
+
+    rlImGuiShutdown();
+    CloseWindow();
+
+    return saved ? 0 : 1;
+}
+
+static void TableScene(int frame)
+{
+    constexpr int rows = 10000;
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Table", nullptr, ImGuiWindowFlags_NoDecoration);
+
+    ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("rows", 4, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Id");
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Value");
+        ImGui::TableSetupColumn("Progress");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(rows);
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", row);
+                ImGui::TableNextColumn();
+                ImGui::Text("Item %05d", row * 7919 % rows);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", row * 0.125f);
+                ImGui::TableNextColumn();
+                ImGui::ProgressBar(float((row + frame) % 100) / 100.0f, ImVec2(-1, 0));
+            }
+        }
+
+        // scroll through the whole table over the run
+        ImGui::SetScrollY(float(frame * 97 % (rows * 20)));
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+static void DrawListScene(int frame)
+{
+    constexpr int primitives = 50000;
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Draw lists", nullptr, ImGuiWindowFlags_NoDecoration);
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImVec2 size = ImGui::GetContentRegionAvail();
+
+    drawList->PushClipRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), true);
+    for (int i = 0; i < primitives; i++)
+    {
+        float x = origin.x + float((i * 37 + frame) % int(size.x));
+        float y = origin.y + float((i * 53) % int(size.y));
+        ImU32 color = IM_COL32((i * 13) & 255, (i * 29) & 255, (i * 7) & 255, 255);
+
+        switch (i % 3)
+        {
+        case 0: drawList->AddRectFilled(ImVec2(x, y), ImVec2(x + 6, y + 6), color); break;
+        case 1: drawList->AddLine(ImVec2(x, y), ImVec2(x + 12, y + 4), color); break;
+        default: drawList->AddText(ImVec2(x, y), color, "rl"); break;
+        }
+
+        // clip rect changes split the list into many commands
+        if (i % 1000 == 999)
+        {
+            drawList->PopClipRect();
+            drawList->PushClipRect(origin, ImVec2(origin.x + size.x - float(i % 50), origin.y + size.y), true);
+        }
+    }
+    drawList->PopClipRect();
+
+    ImGui::End();
+}
+
+struct Percentiles
+{
+    double P50 = 0, P90 = 0, P99 = 0, Max = 0, Mean = 0;
+};
+
+static Percentiles GetPercentiles(std::vector<double> values)
+{
+    Percentiles result;
+    if (values.empty())
+        return result;
+
+    std::sort(values.begin(), values.end());
+    auto at = [&values](double p) { return values[std::min(values.size() - 1, size_t(p * double(values.size() - 1) + 0.5))]; };
+
+    result.P50 = at(0.50);
+    result.P90 = at(0.90);
+    result.P99 = at(0.99);
+    result.Max = values.back();
+    for (double value : values)
+        result.Mean += value / double(values.size());
+
+    return result;
+}
+
+static void WritePercentiles(FILE* file, const char* name, const Percentiles& p, bool last)
+{
+    fprintf(file, "      \"%s\": { \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"mean\": %.4f }%s\n",
+        name, p.P50, p.P90, p.P99, p.Max, p.Mean, last ? "" : ",");
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 2 && strcmp(argv[1], "--record") == 0)
+        return RecordSession(argv[2]);
+
+    int frames = argc > 1 ? std::max(1, atoi(argv[1])) : 300;
+    const char* outputPath = argc > 2 ? argv[2] : nullptr;
+    const char* sessionPath = argc > 3 ? argv[3] : nullptr;
+
+    constexpr int screenWidth = 1280;
+    constexpr int screenHeight = 800;
+    constexpr int warmupFrames = 10;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(screenWidth, screenHeight, "rlImGui bench");
+    SetTargetFPS(0);
+    rlImGuiSetup(true);
+
+    // window placement must not carry over from other runs
+    ImGui::GetIO().IniFilename = nullptr;
+
+    // everything is drawn here, the hidden window only provides the GL context
+    RenderTexture target = LoadRenderTexture(screenWidth, screenHeight);
+
+    std::vector<Scene> scenes;
+    if (sessionPath != nullptr)
+        scenes.push_back({ "session", SessionScene });
+    scenes.push_back({ "demo", DemoScene });
+    scenes.push_back({ "table_10k_rows", TableScene });
+    scenes.push_back({ "huge_draw_lists", DrawListScene });
+
+    FILE* output = outputPath ? fopen(outputPath, "w") : stdout;
+    if (output == nullptr)
+    {
+        fprintf(stderr, "cannot open %s\n", outputPath);
+        output = stdout;
+    }
+
+    fprintf(output, "{\n  \"frames_per_scene\": %d,\n  \"width\": %d,\n  \"height\": %d,\n  \"scenes\": [\n", frames, screenWidth, screenHeight);
+
+    const int sceneCount = int(scenes.size());
+    for (int s = 0; s < sceneCount; s++)
+    {
+        std::vector<double> frameTimes, renderTimes, eventTimes;
+        double drawLists = 0, drawCommands = 0, vertices = 0, indices = 0, batchFlushes = 0, textureSwitches = 0, scissorChanges = 0;
+
+        // a session is measured from its first frame to its last, it is not the same session without its start
+        bool replay = scenes[s].Draw == SessionScene;
+        if (replay && !rlImGuiStartReplay(sessionPath))
+            fprintf(stderr, "cannot replay %s\n", sessionPath);
+        int skipFrames = replay ? 0 : warmupFrames;
+
+        for (int frame = 0; replay ? rlImGuiIsReplaying() : frame < warmupFrames + frames; frame++)
+        {
+            double start = GetTime();
+
+            BeginDrawing();
+            BeginTextureMode(target);
+            ClearBackground(DARKGRAY);
+
+            rlImGuiBegin();
+            scenes[s].Draw(frame);
+            rlImGuiEnd();
+
+            EndTextureMode();
+            EndDrawing();
+
+            double frameTime = (GetTime() - start) * 1000.0;
+            if (frame < skipFrames)
+                continue;
+
+            rlImGuiRenderStats stats = rlImGuiGetRenderStats();
+            frameTimes.push_back(frameTime);
+            renderTimes.push_back(stats.renderTime);
+            eventTimes.push_back(stats.processEventsTime);
+
+            drawLists += stats.drawLists;
+            drawCommands += stats.drawCommands;
+            vertices += stats.vertices;
+            indices += stats.indices;
+            batchFlushes += stats.batchFlushes;
+            textureSwitches += stats.textureSwitches;
+            scissorChanges += stats.scissorChanges;
+        }
+
+        double measured = std::max<double>(1, double(frameTimes.size()));
+        drawLists /= measured;
+        drawCommands /= measured;
+        vertices /= measured;
+        indices /= measured;
+        batchFlushes /= measured;
+        textureSwitches /= measured;
+        scissorChanges /= measured;
+
+        fprintf(output, "    {\n      \"name\": \"%s\",\n      \"frames\": %d,\n", scenes[s].Name, int(frameTimes.size()));
+        WritePercentiles(output, "frame_ms", GetPercentiles(frameTimes), false);
+        WritePercentiles(output, "render_draw_data_ms", GetPercentiles(renderTimes), false);
+        WritePercentiles(output, "process_events_ms", GetPercentiles(eventTimes), false);
+        fprintf(output, "      \"counters\": { \"draw_lists\": %.1f, \"draw_commands\": %.1f, \"vertices\": %.1f, \"indices\": %.1f, "
+            "\"batch_flushes\": %.1f, \"texture_switches\": %.1f, \"scissor_changes\": %.1f }\n",
+            drawLists, drawCommands, vertices, indices, batchFlushes, textureSwitches, scissorChanges);
+        fprintf(output, "    }%s\n", s + 1 < sceneCount ? "," : "");
+    }
+
+    fprintf(output, "  ]\n}\n");
+    if (output != stdout)
+        fclose(output);
+
+    UnloadRenderTexture(target);
+    rlImGuiShutdown();
+    CloseWindow();
+
+    return 0;
+}
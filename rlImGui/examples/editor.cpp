@@ -20,6 +20,7 @@
 bool Quit = false;
 
 bool ImGuiDemoOpen = false;
+bool RenderStatsOpen = false;
 
 // DPI scaling functions
 float ScaleToDPIF(float value)
@@ -37,7 +38,10 @@ class DocumentWindow
 public:
 	bool Open = false;
 
-	RenderTexture ViewTexture;
+	// pooled by rlImGui, sized to the content area instead of the screen
+	RenderTexture* ViewTexture = nullptr;
+	int ViewWidth = 0;
+	int ViewHeight = 0;
 
 	virtual void Setup() = 0;
 	virtual void Shutdown() = 0;
@@ -47,6 +51,27 @@ public:
 	bool Focused = false;
 
 	Rectangle ContentRect = { 0 };
+
+protected:
+	// follows the content area saved by Show, returns true when the view needs to be redrawn at a new size
+	bool UpdateViewSize()
+	{
+		int width = ContentRect.width > 1 ? (int)ContentRect.width : 1;
+		int height = ContentRect.height > 1 ? (int)ContentRect.height : 1;
+		if (ViewTexture && width == ViewWidth && height == ViewHeight)
+			return false;
+
+		ViewTexture = rlImGuiResizeRenderTarget(ViewTexture, width, height);
+		ViewWidth = width;
+		ViewHeight = height;
+		return true;
+	}
+
+	void ReleaseView()
+	{
+		rlImGuiReleaseRenderTarget(ViewTexture);
+		ViewTexture = nullptr;
+	}
 };
 
 class ImageViewerWindow : public DocumentWindow
@@ -59,10 +84,10 @@ public:
 		Camera.target.x = 0;
 		Camera.target.y = 0;
 		Camera.rotation = 0;
-		Camera.offset.x = GetScreenWidth() / 2.0f;
-		Camera.offset.y = GetScreenHeight() / 2.0f;
 
-		ViewTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+		ContentRect.width = ScaleToDPIF(400.0f);
+		ContentRect.height = ScaleToDPIF(400.0f);
+		UpdateViewSize();
 		ImageTexture = LoadTexture("resources/parrots.png");
 
 		UpdateRenderTexture();
@@ -82,15 +107,6 @@ public:
 
 			Focused = ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows);
 
-			ImVec2 size = ImGui::GetContentRegionAvail();
-
-			// center the scratch pad in the view
-			Rectangle viewRect = { 0 };
-			viewRect.x = ViewTexture.texture.width / 2 - size.x / 2;
-			viewRect.y = ViewTexture.texture.height / 2 - size.y / 2;
-			viewRect.width = size.x;
-			viewRect.height = -size.y;
-
 			if (ImGui::BeginChild("Toolbar", ImVec2(ImGui::GetContentRegionAvail().x, 25)))
 			{
 				ImGui::SetCursorPosX(2);
@@ -125,7 +141,7 @@ public:
 				ImGui::EndChild();
 			}
 
-			rlImGuiImageRect(&ViewTexture.texture, (int)size.x, (int)size.y, viewRect);	
+			rlImGuiImageRenderTarget(ViewTexture, ViewWidth, ViewHeight);
 		}
 		ImGui::End();
 		ImGui::PopStyleVar();
@@ -136,14 +152,8 @@ public:
 		if (!Open)
 			return;
 
-		if (IsWindowResized())
-		{
-			UnloadRenderTexture(ViewTexture);
-			ViewTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
-
-			Camera.offset.x = GetScreenWidth() / 2.0f;
-			Camera.offset.y = GetScreenHeight() / 2.0f;
-		}
+		if (UpdateViewSize())
+			DirtyScene = true;
 
 		Vector2 mousePos = GetMousePosition();
 
@@ -206,7 +216,11 @@ public:
 
 	void UpdateRenderTexture()
 	{
-		BeginTextureMode(ViewTexture);
+		// keep the camera target in the center of the view
+		Camera.offset.x = ViewWidth / 2.0f;
+		Camera.offset.y = ViewHeight / 2.0f;
+
+		rlImGuiBeginRenderTarget(ViewTexture, ViewWidth, ViewHeight);
 		ClearBackground(BLUE);
 
 		// camera with our view offset with a world origin of 0,0
@@ -221,7 +235,7 @@ public:
 
 	void Shutdown() override
 	{
-		UnloadRenderTexture(ViewTexture);
+		ReleaseView();
 		UnloadTexture(ImageTexture);
 	}
 };
@@ -233,7 +247,9 @@ public:
 
 	void Setup() override
 	{
-		ViewTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+		ContentRect.width = ScaleToDPIF(400.0f);
+		ContentRect.height = ScaleToDPIF(400.0f);
+		UpdateViewSize();
 
 		Camera.fovy = 45;
 		Camera.up.y = 1;
@@ -250,7 +266,7 @@ public:
 
 	void Shutdown() override
 	{
-		UnloadRenderTexture(ViewTexture);
+		ReleaseView();
 		UnloadTexture(GridTexture);
 	}
 
@@ -262,8 +278,11 @@ public:
 		if (ImGui::Begin("3D View", &Open, ImGuiWindowFlags_NoScrollbar))
 		{
 			Focused = ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows);
+			ContentRect.width = ImGui::GetContentRegionAvail().x;
+			ContentRect.height = ImGui::GetContentRegionAvail().y;
+
 			// draw the view
-			rlImGuiImageRenderTextureFit(&ViewTexture, true);
+			rlImGuiImageRenderTarget(ViewTexture, ViewWidth, ViewHeight);
 		}
 		ImGui::End();
 		ImGui::PopStyleVar();
@@ -274,21 +293,17 @@ public:
 		if (!Open)
 			return;
 
-		if (IsWindowResized())
-		{
-			UnloadRenderTexture(ViewTexture);
-			ViewTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
-		}
+		UpdateViewSize();
 
 		float period = 10;
 		float magnitude = 25;
 
 		Camera.position.x = (float)(sinf((float)GetTime() / period) * magnitude);
 
-		BeginTextureMode(ViewTexture);
+		rlImGuiBeginRenderTarget(ViewTexture, ViewWidth, ViewHeight);
 		ClearBackground(SKYBLUE);
 
-		BeginMode3D(Camera);
+		rlImGuiBeginRenderTargetMode3D(Camera);
 
 		// grid of cube trees on a plane to make a "world"
 		DrawPlane(Vector3{ 0, 0, 0 }, Vector2{ 50, 50 }, BEIGE); // simple world plane
@@ -337,6 +352,7 @@ void DoMainMenu()
 			ImGui::MenuItem("ImGui Demo", nullptr, &ImGuiDemoOpen);
 			ImGui::MenuItem("Image Viewer", nullptr, &ImageViewer.Open);
 			ImGui::MenuItem("3D View", nullptr, &SceneView.Open);
+			ImGui::MenuItem("Render Stats", nullptr, &RenderStatsOpen);
 
 			ImGui::EndMenu();
 		}
@@ -357,6 +373,7 @@ int main(int argc, char* argv[])
 	InitWindow(screenWidth, screenHeight, "raylib-Extras [ImGui] example - Editor Example");
 	SetTargetFPS(144);
 	rlImGuiSetup(true);
+	rlImGuiSetLowLatency(true);
 	ImGui::GetIO().ConfigWindowsMoveFromTitleBarOnly = true;
 
 	ImageViewer.Setup();
@@ -386,16 +403,20 @@ int main(int argc, char* argv[])
 		if (SceneView.Open)
 			SceneView.Show();
 
+		if (RenderStatsOpen)
+			rlImGuiShowRenderStats(&RenderStatsOpen);
+
 		rlImGuiEnd();
 
 		EndDrawing();
+		rlImGuiMarkPresent();
 		//----------------------------------------------------------------------------------
 	}
-	rlImGuiShutdown();
-
 	ImageViewer.Shutdown();
 	SceneView.Shutdown();
 
+	rlImGuiShutdown();
+
 	// De-Initialization
 	//--------------------------------------------------------------------------------------   
 	CloseWindow();        // Close window and OpenGL context
@@ -30,16 +30,127 @@
 #include "rlImGui.h"
 
 #include "imgui_impl_raylib.h"
+#include "rlImGuiConvert.h"
+#include "rlImGuiKeymap.h"
 
 #include "raylib.h"
+#include "raymath.h"
 #include "rlgl.h"
 
 #include "imgui.h"
 
 #include <math.h>
-#include <map>
 #include <limits>
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <float.h>
+#include <stdio.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+// Renderer selection
+// By default every ImDrawList is uploaded once per frame into persistent GPU vertex/index buffers
+// and each ImDrawCmd is issued as a single indexed draw.
+// Define RLIMGUI_IMMEDIATE_RENDERER to use the rlgl immediate mode path (rlBegin/rlVertex) instead.
+// OpenGL 1.1 has no buffer objects, so it always uses the immediate mode path.
+#if !defined(RLIMGUI_IMMEDIATE_RENDERER) && !defined(GRAPHICS_API_OPENGL_11)
+#define RLIMGUI_RETAINED_RENDERER
+#endif
+
+// Frame rate rlImGuiSkipFrame paces idle frames at, raylib does not expose the SetTargetFPS value
+#ifndef RLIMGUI_IDLE_FPS
+#define RLIMGUI_IDLE_FPS 60
+#endif
+
+// ImGui 1.92 lets the renderer create and update its textures, atlas included, through ImDrawData::Textures
+#if IMGUI_VERSION_NUM >= 19200
+#define RLIMGUI_DYNAMIC_TEXTURES
+#endif
+
+// define RLIMGUI_ALPHA8_FONT_ATLAS to store the font atlas at one byte per texel, expanded to white + alpha by a shader.
+// OpenGL 1.1 has no shaders, so it always uses an RGBA atlas
+#if defined(RLIMGUI_ALPHA8_FONT_ATLAS) && defined(GRAPHICS_API_OPENGL_11)
+#undef RLIMGUI_ALPHA8_FONT_ATLAS
+#endif
+
+// define RLIMGUI_SDF_FONTS to bake the font atlas once as a signed distance field and draw text at any size with a shader.
+// It converts the prebuilt atlas of ImGui before 1.92 (1.92 rasterizes each size on demand), and OpenGL 1.1 has no shaders
+#if defined(RLIMGUI_SDF_FONTS) && (defined(GRAPHICS_API_OPENGL_11) || defined(RLIMGUI_DYNAMIC_TEXTURES))
+#undef RLIMGUI_SDF_FONTS
+#endif
+
+// pixel size the SDF atlas is baked at, and how many texels the distance field reaches past the glyph edges
+#ifndef RLIMGUI_SDF_FONT_SIZE
+#define RLIMGUI_SDF_FONT_SIZE 32
+#endif
+#ifndef RLIMGUI_SDF_SPREAD
+#define RLIMGUI_SDF_SPREAD 4
+#endif
+
+// Tiles of rlImGuiTiledImage kept on the GPU, shared by all tiled images, and tile files requested per frame at most
+#ifndef RLIMGUI_TILE_CACHE_SIZE
+#define RLIMGUI_TILE_CACHE_SIZE 256
+#endif
+#ifndef RLIMGUI_TILE_LOADS_PER_FRAME
+#define RLIMGUI_TILE_LOADS_PER_FRAME 4
+#endif
+
+// Worker threads decoding rlImGuiImageAsync files, 0 to use one less than the CPU cores (at most 4)
+#ifndef RLIMGUI_IMAGE_WORKERS
+#define RLIMGUI_IMAGE_WORKERS 0
+#endif
+
+// Frames an unloaded or failed image file stays known after it was last drawn, then its entry is deleted
+#ifndef RLIMGUI_IMAGE_IDLE_FRAMES
+#define RLIMGUI_IMAGE_IDLE_FRAMES 600
+#endif
+
+// Render target pool, sizes are rounded up to multiples of RLIMGUI_RENDER_TARGET_BUCKET pixels,
+// targets released for longer than RLIMGUI_RENDER_TARGET_KEEP_SECONDS are unloaded
+#ifndef RLIMGUI_RENDER_TARGET_BUCKET
+#define RLIMGUI_RENDER_TARGET_BUCKET 256
+#endif
+#ifndef RLIMGUI_RENDER_TARGET_KEEP_SECONDS
+#define RLIMGUI_RENDER_TARGET_KEEP_SECONDS 2.0
+#endif
+
+// Thumbnail atlas, pages of square slots of RLIMGUI_THUMBNAIL_SIZE pixels shared by all thumbnail grids and packed images
+#ifndef RLIMGUI_THUMBNAIL_SIZE
+#define RLIMGUI_THUMBNAIL_SIZE 128
+#endif
+#ifndef RLIMGUI_THUMBNAIL_PAGE_SIZE
+#define RLIMGUI_THUMBNAIL_PAGE_SIZE 2048
+#endif
+#ifndef RLIMGUI_THUMBNAIL_PAGES
+#define RLIMGUI_THUMBNAIL_PAGES 4
+#endif
+
+// Raw input arrival is timestamped by chaining raylib's GLFW callbacks, and the low latency mode reads the cursor
+// from GLFW. Desktop raylib bundles GLFW, define RLIMGUI_NO_GLFW to only use raylib's input functions.
+#if (defined(PLATFORM_DESKTOP) || defined(PLATFORM_DESKTOP_GLFW)) && !defined(RLIMGUI_NO_GLFW)
+#define RLIMGUI_GLFW_INPUT
+#define GLFW_INCLUDE_NONE
+#include "GLFW/glfw3.h"
+#endif
+
+// GL functions rlgl does not wrap are loaded through GLFW, separately from the input hooks above.
+// Define RLIMGUI_NO_GL_LOADER to only draw through rlgl.
+#if (defined(PLATFORM_DESKTOP) || defined(PLATFORM_DESKTOP_GLFW)) && !defined(GRAPHICS_API_OPENGL_11) && !defined(RLIMGUI_NO_GL_LOADER)
+#define RLIMGUI_GL_LOADER
+#define GLFW_INCLUDE_NONE
+#include "GLFW/glfw3.h"
+
+// GL functions use the stdcall convention on 32 bit Windows, the loaded pointers have to be declared with it
+#if defined(_WIN32)
+#define RLIMGUI_GLAPI __stdcall
+#else
+#define RLIMGUI_GLAPI
+#endif
+#endif
 
 #ifndef NO_FONT_AWESOME
 #include "extras/FA6FreeSolidFontData.h"
@@ -50,7 +161,16 @@ static MouseCursor MouseCursorMap[ImGuiMouseCursor_COUNT];
 
 ImGuiContext* GlobalContext = nullptr;
 
-static std::map<KeyboardKey, ImGuiKey> RaylibKeyMap;
+// raylib keys that went down and have not been seen released yet
+static ImVector<int> HeldKeys;
+
+// raylib's keyboard, as rlImGuiKeymap::TranslateKeyEvents reads it
+struct RaylibKeyboard
+{
+    static bool IsKeyUp(int key) { return ::IsKeyUp(key); }
+    static bool IsKeyPressed(int key) { return ::IsKeyPressed(key); }
+    static int GetKeyPressed(void) { return ::GetKeyPressed(); }
+};
 
 static bool LastFrameFocused = false;
 
@@ -59,574 +179,4754 @@ static bool LastShiftPressed = false;
 static bool LastAltPressed = false;
 static bool LastSuperPressed = false;
 
-// internal only functions
-bool rlImGuiIsControlDown() { return IsKeyDown(KEY_RIGHT_CONTROL) || IsKeyDown(KEY_LEFT_CONTROL); }
-bool rlImGuiIsShiftDown() { return IsKeyDown(KEY_RIGHT_SHIFT) || IsKeyDown(KEY_LEFT_SHIFT); }
-bool rlImGuiIsAltDown() { return IsKeyDown(KEY_RIGHT_ALT) || IsKeyDown(KEY_LEFT_ALT); }
-bool rlImGuiIsSuperDown() { return IsKeyDown(KEY_RIGHT_SUPER) || IsKeyDown(KEY_LEFT_SUPER); }
+// one input event fed to ImGui, as stored in a recording
+enum class InputEventType : unsigned char
+{
+    Focus,
+    Key,
+    KeyAnalog,
+    Char,
+    MousePos,
+    MouseButton,
+    MouseWheel,
+};
+
+struct RecordedInputEvent
+{
+    InputEventType Type;
+    unsigned char Down;
+    unsigned short Reserved;
+    unsigned int Code;              // ImGuiKey, mouse button or character
+    float X;                        // mouse position, wheel or analog value
+    float Y;
+};
+
+// what ImGuiNewFrame set up for one frame, followed in the file by EventCount events
+struct RecordedInputFrame
+{
+    unsigned int Frame;
+    unsigned int EventCount;
+    float DeltaTime;
+    float DisplayWidth;
+    float DisplayHeight;
+};
+
+static constexpr unsigned int InputRecordMagic = 0x52494c52; // "RLIR"
+static constexpr unsigned int InputRecordVersion = 1;
+
+// recording, kept in memory and written by rlImGuiStopRecording
+static bool Recording = false;
+static char RecordPath[512] = { 0 };
+static ImVector<unsigned char> RecordData;
+static int RecordFrameOffset = -1;
+static unsigned int RecordFrameCount = 0;
+static RecordedInputEvent LastRecordedMousePos = { InputEventType::MousePos, 0, 0, 0, -FLT_MAX, -FLT_MAX };
+
+// replay, the whole file is validated when loaded
+static bool Replaying = false;
+static ImVector<unsigned char> ReplayData;
+static int ReplayOffset = 0;
+static RecordedInputFrame ReplayFrame = { 0 };
+static bool InputResetPending = false;
+
+// input to present latency of the frame being built, all in GetTime seconds
+static double FrameInputTime = 0;           // oldest raw input event the frame sampled, or the sample time without one
+static double FrameSampleTime = 0;
+static double FrameProcessTime = 0;
+static int FrameRawInputEvents = 0;
+static double PresentInputTime = 0;         // input time of the last submitted frame, until rlImGuiMarkPresent
+static bool PresentPending = false;
+static bool LowLatencyMouse = false;
+
+#ifdef RLIMGUI_GLFW_INPUT
+// raw input that arrived since the last frame sampled input, stamped from raylib's GLFW callbacks
+static GLFWwindow* InputWindow = nullptr;
+static double RawInputTime = -1;
+static int RawInputEvents = 0;
+static double RawCursorX = 0;
+static double RawCursorY = 0;
+
+static GLFWcursorposfun PrevCursorPosCallback = nullptr;
+static GLFWmousebuttonfun PrevMouseButtonCallback = nullptr;
+static GLFWscrollfun PrevScrollCallback = nullptr;
+static GLFWkeyfun PrevKeyCallback = nullptr;
+static GLFWcharfun PrevCharCallback = nullptr;
+
+// a mouse event with the GetTime it arrived at, ImGui's input queue has no timestamps so only rlImGuiGetMouseMoves sees it
+struct QueuedMouseEvent
+{
+    RecordedInputEvent Event;
+    double Time;
+};
+
+// every cursor move and button transition since the last frame, in arrival order, forwarded to ImGui's
+// input queue instead of one position and button state per frame
+static bool UseMouseEventQueue = true;
+static ImVector<QueuedMouseEvent> MouseEventQueue;
+static ImVector<QueuedMouseEvent> ForwardedMouseMoves;     // the moves forwarded this frame
+static constexpr int MouseEventQueueLimit = 1024;
+#endif
 
-void ReloadFonts(void)
+// font atlas build started by rlImGuiBeginSetupAsync, finished and uploaded by rlImGuiEndSetupAsync
+static std::thread FontBuildThread;
+static std::atomic<bool> FontBuildDone{ false };
+static float FontBuildDPIScale = 1.0f;
+static bool FontBuildHighDPI = false;
+
+// the DPI scale fonts are baked for, unknown before the window exists and taken as 1 until then
+static float GetFontDPIScale(void)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    unsigned char* pixels = nullptr;
+#if !defined(__APPLE__)
+    if (IsWindowReady())
+        return GetWindowScaleDPI().y;
+#endif
+    return 1.0f;
+}
 
-    int width;
-    int height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height, nullptr);
-    Image image = GenImageColor(width, height, BLANK);
-    memcpy(image.data, pixels, width * height * 4);
+// read on the thread that owns the window, the fonts are then built from the values passed in
+static bool GetFontHighDPI(void)
+{
+    return IsWindowState(FLAG_WINDOW_HIGHDPI);
+}
 
-    Texture2D* fontTexture = (Texture2D*)io.Fonts->TexID;
-    if (fontTexture && fontTexture->id != 0)
-    {
-        UnloadTexture(*fontTexture);
-        MemFree(fontTexture);
-    }
+// a run of adjacent ImDrawCmds that share texture, clip rect and vertex offset, submitted as one draw
+struct DrawBatch
+{
+    const ImDrawCmd* Command = nullptr;   // first command of the run, holds the shared state
+    unsigned int IdxOffset = 0;
+    unsigned int ElemCount = 0;
+    int Scissor[4] = { 0 };               // clip rect in framebuffer pixels
+};
+
+// GL state last set while submitting the current frame, so redundant rlgl calls can be skipped.
+// Everything in here is invalidated after a user callback, which may change any of it.
+struct RenderStateCache
+{
+    ImVec2 DisplayPos;
+    ImVec2 DisplaySize;
+    ImVec2 FramebufferScale;        // resolved once per frame, including the FLAG_WINDOW_HIGHDPI check
 
-    fontTexture = (Texture2D*)MemAlloc(sizeof(Texture2D));
-    *fontTexture = LoadTextureFromImage(image);
-    UnloadImage(image);
-    io.Fonts->TexID = (ImTextureID)fontTexture;
+    bool ScissorValid = false;
+    int Scissor[4] = { 0 };
+    unsigned int TextureId = 0;     // 0 when unknown, rlgl never hands out texture id 0
+    unsigned int ShaderId = 0;      // 0 when unknown
+    bool BlendAndCullValid = false;
+};
+
+static RenderStateCache StateCache;
+
+static ImVector<DrawBatch> DrawBatches;
+
+static rlImGuiRenderStats RenderStats = { 0 };
+
+// set with rlImGuiSetShader, rlgl can not tell which shader BeginShaderMode made current
+static Shader BaseShader = { 0 };
+
+// the shader plain ImGui geometry is drawn with where the renderer picks one itself
+static Shader GetBaseShader(void)
+{
+    if (BaseShader.id != 0)
+        return BaseShader;
+    return Shader{ rlGetShaderIdDefault(), rlGetShaderLocsDefault() };
 }
+static float ProcessEventsTime = 0;
+
+// the last RLIMGUI_STATS_HISTORY frames of RenderStats, StatsHistoryNext is the oldest once the buffer is full
+static rlImGuiRenderStats StatsHistory[RLIMGUI_STATS_HISTORY];
+static int StatsHistoryNext = 0;
+static int StatsHistoryCount = 0;
+
+// idle frame skipping, see rlImGuiPrepareFrame
+static bool FramePrepared = false;
+static uint64_t PreparedFrameHash = 0;
+static uint64_t PresentedFrameHash = 0;
+static bool FrameInvalidated = false;      // set by rlImGuiInvalidateFrame, the next prepared frame counts as changed
+static bool MeasureFrameTime = false;
+static double LastBeginTime = 0;
+static double FrameStartTime = 0;
+static int IdleFramesSkipped = 0;
+static int TotalFramesSkipped = 0;
+
+// cached UI layer, see rlImGuiSetCachedLayer
+static bool UseCachedLayer = false;
+static RenderTexture UILayer = { 0 };
+static bool UILayerValid = false;
+static uint64_t UILayerHash = 0;
+static int UILayerReuses = 0;
+
+// a deep copy of one frame of draw data, see rlImGuiEndSnapshot.
+// The vertices, indices and commands of all lists live in one arena that only grows,
+// the ImDrawLists point into it and never own their buffers.
+struct DrawDataSnapshot
+{
+    std::mutex Lock;                // held while the snapshot is written or drawn
+    ImDrawData Data;
+    ImVector<ImDrawList*> Lists;
+    ImVector<char> Arena;
+};
+
+// double buffered, the UI thread writes the slot that is not published while the GL thread draws the other
+static DrawDataSnapshot Snapshots[2];
+static std::atomic<int> PublishedSnapshot{ -1 };
+
+#ifdef RLIMGUI_RETAINED_RENDERER
+struct RetainedBuffers
+{
+    unsigned int VaoId = 0;
+    unsigned int VboId = 0;
+    unsigned int IboId = 0;
+    int VertexCapacity = 0;
+    int IndexCapacity = 0;
+};
+
+static RetainedBuffers GPUBuffers;
+
+// rlDrawVertexArrayElements only draws 16 bit indices. 32 bit ImDrawIdx is drawn with glDrawElements loaded
+// through GLFW, ES2 has no 32 bit indices without an extension. Where it can not be loaded the draw data is
+// de-indexed into DeindexedVertices on upload and drawn with plain vertex array draws instead.
+#if defined(RLIMGUI_GL_LOADER) && !defined(GRAPHICS_API_OPENGL_ES2)
+#define RLIMGUI_DRAW_ELEMENTS_32
+typedef void (RLIMGUI_GLAPI *DrawElementsProc)(unsigned int mode, int count, unsigned int type, const void* indices);
+static DrawElementsProc DrawElements32 = nullptr;
+#endif
 
-static const char* GetClipTextCallback(ImGuiContext*)
+static ImVector<ImDrawVert> DeindexedVertices;
+
+// SIMD gather picked for this CPU on startup
+static const rlImGuiConvert::DeindexKernel<ImDrawIdx> DeindexVertices = rlImGuiConvert::GetDeindexKernel<ImDrawIdx>();
+#endif
+
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+// single channel textures, drawn with Alpha8Shader
+static ImVector<unsigned int> Alpha8Textures;
+static Shader Alpha8Shader = { 0 };
+
+#if defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_OPENGL_ES3)
+static const char* Alpha8FragmentShader = R"(#version 100
+precision mediump float;
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+void main()
 {
-    return GetClipboardText();
+    gl_FragColor = vec4(1.0, 1.0, 1.0, texture2D(texture0, fragTexCoord).r) * fragColor * colDiffuse;
+}
+)";
+#elif defined(GRAPHICS_API_OPENGL_21)
+static const char* Alpha8FragmentShader = R"(#version 120
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+void main()
+{
+    gl_FragColor = vec4(1.0, 1.0, 1.0, texture2D(texture0, fragTexCoord).r) * fragColor * colDiffuse;
+}
+)";
+#else
+static const char* Alpha8FragmentShader = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main()
+{
+    finalColor = vec4(1.0, 1.0, 1.0, texture(texture0, fragTexCoord).r) * fragColor * colDiffuse;
 }
+)";
+#endif
 
-static void SetClipTextCallback(ImGuiContext*, const char* text)
+static void AddAlpha8Texture(unsigned int textureId)
 {
-    SetClipboardText(text);
+    // raylib's default vertex shader, only the fragment stage differs
+    if (Alpha8Shader.id == 0)
+        Alpha8Shader = LoadShaderFromMemory(nullptr, Alpha8FragmentShader);
+
+    Alpha8Textures.push_back(textureId);
 }
 
-static void ImGuiNewFrame(float deltaTime)
+static void RemoveAlpha8Texture(unsigned int textureId)
 {
-    ImGuiIO& io = ImGui::GetIO();
+    Alpha8Textures.find_erase_unsorted(textureId);
+}
 
-    Vector2 resolutionScale = GetWindowScaleDPI();
+static bool IsAlpha8Texture(unsigned int textureId)
+{
+    return Alpha8Textures.contains(textureId);
+}
 
-#ifndef PLATFORM_DRM
-    if (IsWindowFullscreen())
-    {
-        int monitor = GetCurrentMonitor();
-        io.DisplaySize.x = float(GetMonitorWidth(monitor));
-        io.DisplaySize.y = float(GetMonitorHeight(monitor));
-    }
-    else
-    {
-        io.DisplaySize.x = float(GetScreenWidth());
-        io.DisplaySize.y = float(GetScreenHeight());
-    }
+static void UnloadAlpha8Shader(void)
+{
+    if (Alpha8Shader.id != 0)
+        UnloadShader(Alpha8Shader);
 
-#if !defined(__APPLE__)
-    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
-        resolutionScale = Vector2{ 1,1 };
-#endif
-#else
-    io.DisplaySize.x = float(GetScreenWidth());
-    io.DisplaySize.y = float(GetScreenHeight());
+    Alpha8Shader = Shader{ 0 };
+    Alpha8Textures.clear();
+}
 #endif
 
-    io.DisplayFramebufferScale = ImVec2(resolutionScale.x, resolutionScale.y);
-
-    if (deltaTime <= 0)
-        deltaTime = 0.001f;
+#ifdef RLIMGUI_SDF_FONTS
+// the font atlas holds distances to the glyph edges instead of coverage, drawn with SDFShader
+static unsigned int SDFTexture = 0;
+static Shader SDFShader = { 0 };
 
-    io.DeltaTime = deltaTime;
+// the default font, baked once at RLIMGUI_SDF_FONT_SIZE and scaled to its display size every frame
+static ImFont* SDFDefaultFont = nullptr;
+static float SDFDefaultFontScale = 1.0f;
 
-    if (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_HasMouseCursors)
-    {
-        if ((io.ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange) == 0)
-        {
-            ImGuiMouseCursor imgui_cursor = ImGui::GetMouseCursor();
-            if (imgui_cursor != CurrentMouseCursor || io.MouseDrawCursor)
-            {
-                CurrentMouseCursor = imgui_cursor;
-                if (io.MouseDrawCursor || imgui_cursor == ImGuiMouseCursor_None)
-                {
-                    HideCursor();
-                }
-                else
-                {
-                    ShowCursor();
+// an alpha8 atlas is sampled as (r, r, r, 1), an RGBA one as (1, 1, 1, a)
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+#define RLIMGUI_SDF_CHANNEL "r"
+#else
+#define RLIMGUI_SDF_CHANNEL "a"
+#endif
 
-                    if (!(io.ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange))
-                    {
-                        SetMouseCursor((imgui_cursor > -1 && imgui_cursor < ImGuiMouseCursor_COUNT) ? MouseCursorMap[imgui_cursor] : MOUSE_CURSOR_DEFAULT);
-                    }
-                }
-            }
-        }
-    }
+// smoothstep over one screen pixel around the edge, whatever scale the atlas is drawn at
+#if defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_OPENGL_ES3)
+static const char* SDFFragmentShader = R"(#version 100
+#extension GL_OES_standard_derivatives : enable
+precision mediump float;
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+void main()
+{
+    float distance = texture2D(texture0, fragTexCoord).)" RLIMGUI_SDF_CHANNEL R"(;
+    float width = max(fwidth(distance) * 0.5, 0.0001);
+    gl_FragColor = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - width, 0.5 + width, distance)) * fragColor * colDiffuse;
+}
+)";
+#elif defined(GRAPHICS_API_OPENGL_21)
+static const char* SDFFragmentShader = R"(#version 120
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+void main()
+{
+    float distance = texture2D(texture0, fragTexCoord).)" RLIMGUI_SDF_CHANNEL R"(;
+    float width = max(fwidth(distance) * 0.5, 0.0001);
+    gl_FragColor = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - width, 0.5 + width, distance)) * fragColor * colDiffuse;
 }
+)";
+#else
+static const char* SDFFragmentShader = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main()
+{
+    float distance = texture(texture0, fragTexCoord).)" RLIMGUI_SDF_CHANNEL R"(;
+    float width = max(fwidth(distance) * 0.5, 0.0001);
+    finalColor = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - width, 0.5 + width, distance)) * fragColor * colDiffuse;
+}
+)";
+#endif
 
-static void ImGuiTriangleVert(ImDrawVert& idx_vert)
+static void SetSDFTexture(unsigned int textureId)
 {
-    Color* c;
-    c = (Color*)&idx_vert.col;
-    rlColor4ub(c->r, c->g, c->b, c->a);
-    rlTexCoord2f(idx_vert.uv.x, idx_vert.uv.y);
-    rlVertex2f(idx_vert.pos.x, idx_vert.pos.y);
+    if (SDFShader.id == 0)
+        SDFShader = LoadShaderFromMemory(nullptr, SDFFragmentShader);
+
+    SDFTexture = textureId;
 }
 
-static void ImGuiRenderTriangles(unsigned int count, int indexStart, const ImVector<ImDrawIdx>& indexBuffer, const ImVector<ImDrawVert>& vertBuffer, void* texturePtr)
+static void UnloadSDFShader(void)
 {
-    if (count < 3)
-        return;
+    if (SDFShader.id != 0)
+        UnloadShader(SDFShader);
 
-    Texture* texture = (Texture*)texturePtr;
+    SDFShader = Shader{ 0 };
+    SDFTexture = 0;
+}
 
-    unsigned int textureId = (texture == nullptr) ? 0 : texture->id;
+// offset from a texel to the nearest seed texel, propagated over the atlas by a two pass sweep (8SSEDT)
+struct SDFSeed
+{
+    short X;
+    short Y;
+};
 
-    rlBegin(RL_TRIANGLES);
-    rlSetTexture(textureId);
+static constexpr short SDFNoSeed = 4096;
 
-    for (unsigned int i = 0; i <= (count - 3); i += 3)
-    {
-        ImDrawIdx indexA = indexBuffer[indexStart + i];
-        ImDrawIdx indexB = indexBuffer[indexStart + i + 1];
-        ImDrawIdx indexC = indexBuffer[indexStart + i + 2];
+static inline int SDFSeedDistance(SDFSeed seed)
+{
+    return int(seed.X) * seed.X + int(seed.Y) * seed.Y;
+}
 
-        ImDrawVert vertexA = vertBuffer[indexA];
-        ImDrawVert vertexB = vertBuffer[indexB];
-        ImDrawVert vertexC = vertBuffer[indexC];
+static inline void CompareSDFSeed(SDFSeed* grid, int index, int stride, int offsetX, int offsetY)
+{
+    SDFSeed other = grid[index + offsetX + offsetY * stride];
+    other.X = short(other.X + offsetX);
+    other.Y = short(other.Y + offsetY);
 
-        ImGuiTriangleVert(vertexA);
-        ImGuiTriangleVert(vertexB);
-        ImGuiTriangleVert(vertexC);
-    }
-    rlEnd();
+    if (SDFSeedDistance(other) < SDFSeedDistance(grid[index]))
+        grid[index] = other;
 }
 
-static void EnableScissor(float x, float y, float width, float height)
+// grid has a one texel border of empty cells around width x height, so neighbors never need bounds checks
+static void PropagateSDFSeeds(SDFSeed* grid, int width, int height)
 {
-    rlEnableScissorTest();
-    ImGuiIO& io = ImGui::GetIO();
+    int stride = width + 2;
 
-    ImVec2 scale = io.DisplayFramebufferScale;
-#if !defined(__APPLE__)
-    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
+    for (int y = 1; y <= height; y++)
     {
-        scale.x = 1;
-        scale.y = 1;
+        for (int x = 1; x <= width; x++)
+        {
+            int index = x + y * stride;
+            CompareSDFSeed(grid, index, stride, -1, 0);
+            CompareSDFSeed(grid, index, stride, 0, -1);
+            CompareSDFSeed(grid, index, stride, -1, -1);
+            CompareSDFSeed(grid, index, stride, 1, -1);
+        }
+        for (int x = width; x >= 1; x--)
+            CompareSDFSeed(grid, x + y * stride, stride, 1, 0);
     }
-#endif
 
-    rlScissor((int)(x * scale.x),
-        int((io.DisplaySize.y - (int)(y + height)) * scale.y),
-        (int)(width * scale.x),
-        (int)(height * scale.y));
+    for (int y = height; y >= 1; y--)
+    {
+        for (int x = width; x >= 1; x--)
+        {
+            int index = x + y * stride;
+            CompareSDFSeed(grid, index, stride, 1, 0);
+            CompareSDFSeed(grid, index, stride, 0, 1);
+            CompareSDFSeed(grid, index, stride, -1, 1);
+            CompareSDFSeed(grid, index, stride, 1, 1);
+        }
+        for (int x = 1; x <= width; x++)
+            CompareSDFSeed(grid, x + y * stride, stride, -1, 0);
+    }
 }
 
-static void SetupMouseCursors(void)
+// turns the freshly built coverage atlas into a distance field, in place, and grows every glyph quad
+// by the spread so the field around the glyph edges is drawn too
+static void ConvertAtlasToSDF(ImFontAtlas* atlas)
 {
-    MouseCursorMap[ImGuiMouseCursor_Arrow] = MOUSE_CURSOR_ARROW;
-    MouseCursorMap[ImGuiMouseCursor_TextInput] = MOUSE_CURSOR_IBEAM;
-    MouseCursorMap[ImGuiMouseCursor_Hand] = MOUSE_CURSOR_POINTING_HAND;
-    MouseCursorMap[ImGuiMouseCursor_ResizeAll] = MOUSE_CURSOR_RESIZE_ALL;
-    MouseCursorMap[ImGuiMouseCursor_ResizeEW] = MOUSE_CURSOR_RESIZE_EW;
-    MouseCursorMap[ImGuiMouseCursor_ResizeNESW] = MOUSE_CURSOR_RESIZE_NESW;
-    MouseCursorMap[ImGuiMouseCursor_ResizeNS] = MOUSE_CURSOR_RESIZE_NS;
-    MouseCursorMap[ImGuiMouseCursor_ResizeNWSE] = MOUSE_CURSOR_RESIZE_NWSE;
-    MouseCursorMap[ImGuiMouseCursor_NotAllowed] = MOUSE_CURSOR_NOT_ALLOWED;
-}
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    if (pixels == nullptr)
+        return;
 
-void SetupFontAwesome(void)
-{
-#ifndef NO_FONT_AWESOME
-    static const ImWchar icons_ranges[] = { ICON_MIN_FA, ICON_MAX_FA, 0 };
-    ImFontConfig icons_config;
-    icons_config.MergeMode = true;
-    icons_config.PixelSnapH = true;
-    icons_config.FontDataOwnedByAtlas = false;
+    constexpr float spread = float(RLIMGUI_SDF_SPREAD);
+    int stride = width + 2;
 
-    icons_config.GlyphMaxAdvanceX = std::numeric_limits<float>::max();
-    icons_config.RasterizerMultiply = 1.0f;
-    icons_config.OversampleH = 2;
-    icons_config.OversampleV = 1;
+    ImVector<unsigned char> coverage;
+    coverage.resize(width * height);
+    memcpy(coverage.Data, pixels, coverage.Size);
 
-    icons_config.GlyphRanges = icons_ranges;
+    // insideSeeds finds the nearest covered texel from outside a glyph, outsideSeeds the nearest empty one from inside
+    ImVector<SDFSeed> insideSeeds;
+    ImVector<SDFSeed> outsideSeeds;
+    insideSeeds.resize(stride * (height + 2), SDFSeed{ SDFNoSeed, SDFNoSeed });
+    outsideSeeds.resize(stride * (height + 2), SDFSeed{ SDFNoSeed, SDFNoSeed });
 
-    ImGuiIO& io = ImGui::GetIO();
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            int index = (x + 1) + (y + 1) * stride;
+            if (coverage[x + y * width] >= 128)
+                insideSeeds[index] = SDFSeed{ 0, 0 };
+            else
+                outsideSeeds[index] = SDFSeed{ 0, 0 };
+        }
+    }
 
-    float size = FONT_AWESOME_ICON_SIZE;
-#if !defined(__APPLE__)
-    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
-        size *= GetWindowScaleDPI().y;
+    PropagateSDFSeeds(insideSeeds.Data, width, height);
+    PropagateSDFSeeds(outsideSeeds.Data, width, height);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            int index = (x + 1) + (y + 1) * stride;
+            unsigned char value = coverage[x + y * width];
+
+            // antialiased edge texels already know how far the edge is, to within a texel
+            float distance;
+            if (value > 0 && value < 255)
+                distance = value / 255.0f - 0.5f;
+            else if (value >= 128)
+                distance = sqrtf(float(SDFSeedDistance(outsideSeeds[index]))) - 0.5f;
+            else
+                distance = 0.5f - sqrtf(float(SDFSeedDistance(insideSeeds[index])));
+
+            float normalized = 0.5f + distance / (2.0f * spread);
+            pixels[x + y * width] = (unsigned char)(std::min(std::max(normalized, 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+    }
 
+    // plain rects (the white pixel, mouse cursors, user images) keep their coverage, which the shader passes through
+    for (const ImFontAtlasCustomRect& rect : atlas->CustomRects)
+    {
+        if (rect.Font != nullptr || !rect.IsPacked())
+            continue;
 
-	icons_config.RasterizerMultiply = GetWindowScaleDPI().y;
-#endif
+        for (int y = rect.Y; y < rect.Y + rect.Height; y++)
+            memcpy(pixels + rect.X + y * width, coverage.Data + rect.X + y * width, rect.Width);
+    }
 
-    io.Fonts->AddFontFromMemoryCompressedTTF((void*)fa_solid_900_compressed_data, fa_solid_900_compressed_size, size, &icons_config, icons_ranges);
-#endif
+    for (ImFont* font : atlas->Fonts)
+    {
+        for (ImFontGlyph& glyph : font->Glyphs)
+        {
+            if (!glyph.Visible || glyph.U1 <= glyph.U0 || glyph.V1 <= glyph.V0)
+                continue;
 
+            // glyph units per texel, which differ from 1 when the font was oversampled
+            float scaleX = (glyph.X1 - glyph.X0) / ((glyph.U1 - glyph.U0) * width);
+            float scaleY = (glyph.Y1 - glyph.Y0) / ((glyph.V1 - glyph.V0) * height);
+
+            // the packer leaves 2 * spread texels between glyphs, but none at the atlas edges
+            float left = std::min(spread, glyph.U0 * width);
+            float right = std::min(spread, (1.0f - glyph.U1) * width);
+            float top = std::min(spread, glyph.V0 * height);
+            float bottom = std::min(spread, (1.0f - glyph.V1) * height);
+
+            glyph.X0 -= left * scaleX;
+            glyph.X1 += right * scaleX;
+            glyph.Y0 -= top * scaleY;
+            glyph.Y1 += bottom * scaleY;
+
+            glyph.U0 -= left * atlas->TexUvScale.x;
+            glyph.U1 += right * atlas->TexUvScale.x;
+            glyph.V0 -= top * atlas->TexUvScale.y;
+            glyph.V1 += bottom * atlas->TexUvScale.y;
+        }
+    }
 }
+#endif
 
-void SetupBackend(void)
-{
-    ImGuiIO& io = ImGui::GetIO();
-    io.BackendPlatformName = "imgui_impl_raylib";
-    io.BackendFlags |= ImGuiBackendFlags_HasGamepad | ImGuiBackendFlags_HasSetMousePos;
+// the shader a texture is drawn with, the base shader for anything that is not a special font atlas
+#if defined(RLIMGUI_ALPHA8_FONT_ATLAS) || defined(RLIMGUI_SDF_FONTS)
+#define RLIMGUI_TEXTURE_SHADERS
 
-#ifndef PLATFORM_DRM
-    io.BackendFlags |= ImGuiBackendFlags_HasMouseCursors;
+static Shader GetTextureShader(unsigned int textureId)
+{
+#ifdef RLIMGUI_SDF_FONTS
+    if (textureId == SDFTexture && SDFShader.id != 0)
+        return SDFShader;
+#endif
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+    if (IsAlpha8Texture(textureId))
+        return Alpha8Shader;
+#endif
+    return GetBaseShader();
+}
 #endif
 
-    io.MousePos = ImVec2(0, 0);
+// internal only functions
+bool rlImGuiIsControlDown() { return IsKeyDown(KEY_RIGHT_CONTROL) || IsKeyDown(KEY_LEFT_CONTROL); }
+bool rlImGuiIsShiftDown() { return IsKeyDown(KEY_RIGHT_SHIFT) || IsKeyDown(KEY_LEFT_SHIFT); }
+bool rlImGuiIsAltDown() { return IsKeyDown(KEY_RIGHT_ALT) || IsKeyDown(KEY_LEFT_ALT); }
+bool rlImGuiIsSuperDown() { return IsKeyDown(KEY_RIGHT_SUPER) || IsKeyDown(KEY_LEFT_SUPER); }
 
-    ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
+#ifdef RLIMGUI_DYNAMIC_TEXTURES
+static ImVector<unsigned char> TextureUploadScratch;
 
-    platformIO.Platform_SetClipboardTextFn = SetClipTextCallback;
-    platformIO.Platform_GetClipboardTextFn = GetClipTextCallback;
+static void DestroyTexture(ImTextureData* tex)
+{
+    Texture2D* texture = (Texture2D*)tex->BackendUserData;
+    if (texture)
+    {
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+        RemoveAlpha8Texture(texture->id);
+#endif
+        UnloadTexture(*texture);
+        MemFree(texture);
+    }
 
-    platformIO.Platform_ClipboardUserData = nullptr;
+    tex->SetTexID(ImTextureID_Invalid);
+    tex->BackendUserData = nullptr;
+    tex->SetStatus(ImTextureStatus_Destroyed);
 }
 
-void rlImGuiEndInitImGui(void)
+static void UpdateTexture(ImTextureData* tex)
 {
-    ImGui::SetCurrentContext(GlobalContext);
+    if (tex->Status == ImTextureStatus_WantCreate)
+    {
+        int format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+        if (tex->Format == ImTextureFormat_Alpha8)
+            format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+#else
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+#endif
+
+        Texture2D* texture = (Texture2D*)MemAlloc(sizeof(Texture2D));
+        texture->id = rlLoadTexture(tex->GetPixels(), tex->Width, tex->Height, format, 1);
+        texture->width = tex->Width;
+        texture->height = tex->Height;
+        texture->mipmaps = 1;
+        texture->format = format;
+
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+        if (format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE)
+            AddAlpha8Texture(texture->id);
+#endif
+
+        tex->SetTexID((ImTextureID)texture);
+        tex->BackendUserData = texture;
+        tex->SetStatus(ImTextureStatus_OK);
+    }
+    else if (tex->Status == ImTextureStatus_WantUpdates)
+    {
+        // only the rectangles ImGui touched are sent, each packed into a contiguous block first
+        Texture2D* texture = (Texture2D*)tex->BackendUserData;
+        for (const ImTextureRect& rect : tex->Updates)
+        {
+            int rowSize = rect.w * tex->BytesPerPixel;
+            TextureUploadScratch.resize(rowSize * rect.h);
+            for (int y = 0; y < rect.h; y++)
+                memcpy(TextureUploadScratch.Data + y * rowSize, tex->GetPixelsAt(rect.x, rect.y + y), rowSize);
+
+            UpdateTextureRec(*texture, Rectangle{ float(rect.x), float(rect.y), float(rect.w), float(rect.h) }, TextureUploadScratch.Data);
+        }
+        tex->SetStatus(ImTextureStatus_OK);
+    }
+    else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+    {
+        DestroyTexture(tex);
+    }
+}
+
+static void UpdateTextures(ImVector<ImTextureData*>* textures)
+{
+    if (textures == nullptr)
+        return;
+
+    for (ImTextureData* tex : *textures)
+    {
+        if (tex->Status != ImTextureStatus_OK)
+            UpdateTexture(tex);
+    }
+}
+
+// nothing to prebuild or upload, ImGui rasterizes glyphs as they are first drawn and requests the texture updates
+static void BuildFonts(ImFontAtlas*, float, bool) {}
+static void UploadFonts(void) {}
+
+void ReloadFonts(void)
+{
+    // nothing to do, ImGui requests atlas texture creation and updates through UpdateTextures as fonts change
+}
+#else
+// the uploaded atlas texture, tracked here since ImFontAtlas::Build clears io.Fonts->TexID
+static Texture2D* FontTexture = nullptr;
+
+// CPU copy of the uploaded atlas, compared against to find the rows that changed
+static ImVector<unsigned char> FontPixels;
+
+// baked atlas cache, see rlImGuiSetFontCache
+static char FontCachePath[512] = { 0 };
+
+static constexpr unsigned int FontCacheMagic = 0x43464c52; // "RLFC"
+static constexpr unsigned int FontCacheVersion = 1;
+
+static uint64_t HashBytes(const void* data, size_t size, uint64_t hash);
+
+// everything the baked atlas depends on, read before it is built
+static uint64_t GetFontCacheKey(ImFontAtlas* atlas, float dpiScale, bool highDPI)
+{
+    uint64_t key = 0xcbf29ce484222325ull;
+
+    const int layout[] = { IMGUI_VERSION_NUM, int(sizeof(ImFontGlyph)), int(sizeof(ImFontAtlasCustomRect)), int(sizeof(ImWchar)) };
+    key = HashBytes(layout, sizeof(layout), key);
+
+    key = HashBytes(&dpiScale, sizeof(dpiScale), key);
+    key = HashBytes(&highDPI, sizeof(highDPI), key);
+
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+    const int format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+#else
+    const int format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+#endif
+    key = HashBytes(&format, sizeof(format), key);
+
+    key = HashBytes(&atlas->Flags, sizeof(atlas->Flags), key);
+    key = HashBytes(&atlas->TexDesiredWidth, sizeof(int), key);
+    key = HashBytes(&atlas->TexGlyphPadding, sizeof(int), key);
+    key = HashBytes(&atlas->FontBuilderFlags, sizeof(unsigned int), key);
+    key = HashBytes(&atlas->Fonts.Size, sizeof(int), key);
+
+    for (const ImFontConfig& config : atlas->ConfigData)
+    {
+        key = HashBytes(config.FontData, size_t(config.FontDataSize), key);
+        key = HashBytes(&config.FontDataSize, sizeof(int), key);
+        key = HashBytes(&config.FontNo, sizeof(int), key);
+        key = HashBytes(&config.SizePixels, sizeof(float), key);
+        key = HashBytes(&config.OversampleH, sizeof(int), key);
+        key = HashBytes(&config.OversampleV, sizeof(int), key);
+        key = HashBytes(&config.PixelSnapH, sizeof(bool), key);
+        key = HashBytes(&config.MergeMode, sizeof(bool), key);
+        key = HashBytes(&config.GlyphExtraSpacing, sizeof(ImVec2), key);
+        key = HashBytes(&config.GlyphOffset, sizeof(ImVec2), key);
+        key = HashBytes(&config.GlyphMinAdvanceX, sizeof(float), key);
+        key = HashBytes(&config.GlyphMaxAdvanceX, sizeof(float), key);
+        key = HashBytes(&config.FontBuilderFlags, sizeof(unsigned int), key);
+        key = HashBytes(&config.RasterizerMultiply, sizeof(float), key);
+        key = HashBytes(&config.RasterizerDensity, sizeof(float), key);
+        key = HashBytes(&config.EllipsisChar, sizeof(ImWchar), key);
+
+        int ranges = 0;
+        const ImWchar* glyphRanges = config.GlyphRanges ? config.GlyphRanges : atlas->GetGlyphRangesDefault();
+        while (glyphRanges[ranges] != 0)
+            ranges += 2;
+        key = HashBytes(glyphRanges, ranges * sizeof(ImWchar), key);
+
+        int fontIndex = atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(), atlas->Fonts.end(), config.DstFont));
+        key = HashBytes(&fontIndex, sizeof(int), key);
+    }
+
+    for (const ImFontAtlasCustomRect& rect : atlas->CustomRects)
+    {
+        int fontIndex = rect.Font ? atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(), atlas->Fonts.end(), rect.Font)) : -1;
+        unsigned int glyph = rect.GlyphID;
+        key = HashBytes(&rect.Width, sizeof(unsigned short), key);
+        key = HashBytes(&rect.Height, sizeof(unsigned short), key);
+        key = HashBytes(&glyph, sizeof(glyph), key);
+        key = HashBytes(&rect.GlyphAdvanceX, sizeof(float), key);
+        key = HashBytes(&rect.GlyphOffset, sizeof(ImVec2), key);
+        key = HashBytes(&fontIndex, sizeof(int), key);
+    }
+
+    return key;
+}
+
+static void WriteFontCache(ImVector<unsigned char>& out, const void* data, size_t size)
+{
+    int offset = out.Size;
+    out.resize(offset + int(size));
+    memcpy(out.Data + offset, data, size);
+}
+
+// bounds checked reader over a loaded cache file, any short read marks the whole file invalid
+struct FontCacheReader
+{
+    const unsigned char* Data = nullptr;
+    int Size = 0;
+    int Offset = 0;
+    bool Valid = true;
+
+    const void* Read(size_t size)
+    {
+        if (!Valid || size > size_t(Size - Offset))
+        {
+            Valid = false;
+            return nullptr;
+        }
+
+        const void* data = Data + Offset;
+        Offset += int(size);
+        return data;
+    }
+
+    template<typename T>
+    T Get()
+    {
+        T value = T();
+        if (const void* data = Read(sizeof(T)))
+            memcpy(&value, data, sizeof(T));
+        return value;
+    }
+};
+
+static void SaveFontCache(const ImFontAtlas* atlas, uint64_t key)
+{
+    // the atlas keeps 8 bit coverage unless a font builder produced color glyphs
+    bool alpha8 = atlas->TexPixelsAlpha8 != nullptr;
+    const void* pixels = alpha8 ? (const void*)atlas->TexPixelsAlpha8 : (const void*)atlas->TexPixelsRGBA32;
+    if (pixels == nullptr)
+        return;
+
+    ImVector<unsigned char> out;
+    WriteFontCache(out, &FontCacheMagic, sizeof(unsigned int));
+    WriteFontCache(out, &FontCacheVersion, sizeof(unsigned int));
+    WriteFontCache(out, &key, sizeof(key));
+
+    WriteFontCache(out, &atlas->TexWidth, sizeof(int));
+    WriteFontCache(out, &atlas->TexHeight, sizeof(int));
+    WriteFontCache(out, &alpha8, sizeof(bool));
+    WriteFontCache(out, &atlas->TexPixelsUseColors, sizeof(bool));
+    WriteFontCache(out, &atlas->TexUvScale, sizeof(ImVec2));
+    WriteFontCache(out, &atlas->TexUvWhitePixel, sizeof(ImVec2));
+    WriteFontCache(out, atlas->TexUvLines, sizeof(atlas->TexUvLines));
+    WriteFontCache(out, &atlas->PackIdMouseCursors, sizeof(int));
+    WriteFontCache(out, &atlas->PackIdLines, sizeof(int));
+
+    for (const ImFont* font : atlas->Fonts)
+    {
+        WriteFontCache(out, &font->FontSize, sizeof(float));
+        WriteFontCache(out, &font->Ascent, sizeof(float));
+        WriteFontCache(out, &font->Descent, sizeof(float));
+        WriteFontCache(out, &font->MetricsTotalSurface, sizeof(int));
+        WriteFontCache(out, &font->Glyphs.Size, sizeof(int));
+        WriteFontCache(out, font->Glyphs.Data, font->Glyphs.size_in_bytes());
+    }
+
+    // the rectangles ImGui added for the mouse cursors and baked lines are part of the packed result
+    WriteFontCache(out, &atlas->CustomRects.Size, sizeof(int));
+    for (const ImFontAtlasCustomRect& rect : atlas->CustomRects)
+    {
+        int fontIndex = rect.Font ? atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(), atlas->Fonts.end(), rect.Font)) : -1;
+        WriteFontCache(out, &rect, sizeof(rect));
+        WriteFontCache(out, &fontIndex, sizeof(int));
+    }
+
+    WriteFontCache(out, pixels, size_t(atlas->TexWidth) * atlas->TexHeight * (alpha8 ? 1 : 4));
+
+    if (!SaveFileData(FontCachePath, out.Data, out.Size))
+        TraceLog(LOG_WARNING, "RLIMGUI: Could not write font cache %s", FontCachePath);
+}
+
+static bool LoadFontCache(ImFontAtlas* atlas, uint64_t key)
+{
+    int size = 0;
+    unsigned char* data = LoadFileData(FontCachePath, &size);
+    if (data == nullptr)
+        return false;
+
+    FontCacheReader reader;
+    reader.Data = data;
+    reader.Size = size;
+
+    bool valid = reader.Get<unsigned int>() == FontCacheMagic && reader.Get<unsigned int>() == FontCacheVersion && reader.Get<uint64_t>() == key;
+
+    int width = reader.Get<int>();
+    int height = reader.Get<int>();
+    bool alpha8 = reader.Get<bool>();
+    bool useColors = reader.Get<bool>();
+    ImVec2 uvScale = reader.Get<ImVec2>();
+    ImVec2 uvWhitePixel = reader.Get<ImVec2>();
+    const void* uvLines = reader.Read(sizeof(atlas->TexUvLines));
+    int packIdMouseCursors = reader.Get<int>();
+    int packIdLines = reader.Get<int>();
+
+    struct FontData { float FontSize, Ascent, Descent; int MetricsTotalSurface; int GlyphCount; const void* Glyphs; };
+    ImVector<FontData> fonts;
+    for (int f = 0; f < atlas->Fonts.Size && valid && reader.Valid; f++)
+    {
+        FontData font;
+        font.FontSize = reader.Get<float>();
+        font.Ascent = reader.Get<float>();
+        font.Descent = reader.Get<float>();
+        font.MetricsTotalSurface = reader.Get<int>();
+        font.GlyphCount = reader.Get<int>();
+        font.Glyphs = font.GlyphCount >= 0 ? reader.Read(size_t(font.GlyphCount) * sizeof(ImFontGlyph)) : nullptr;
+        fonts.push_back(font);
+    }
+
+    int rectCount = reader.Get<int>();
+    const unsigned char* rects = rectCount >= 0 ? (const unsigned char*)reader.Read(size_t(rectCount) * (sizeof(ImFontAtlasCustomRect) + sizeof(int))) : nullptr;
+    const void* pixels = (width > 0 && height > 0) ? reader.Read(size_t(width) * height * (alpha8 ? 1 : 4)) : nullptr;
+
+    valid = valid && reader.Valid && fonts.Size == atlas->Fonts.Size && rects != nullptr && pixels != nullptr;
+    if (valid)
+    {
+        // ImGui owns and frees the pixels, so they are copied out of the file buffer
+        atlas->ClearTexData();
+        size_t pixelSize = size_t(width) * height * (alpha8 ? 1 : 4);
+        void* texPixels = IM_ALLOC(pixelSize);
+        memcpy(texPixels, pixels, pixelSize);
+        if (alpha8)
+            atlas->TexPixelsAlpha8 = (unsigned char*)texPixels;
+        else
+            atlas->TexPixelsRGBA32 = (unsigned int*)texPixels;
+
+        atlas->TexWidth = width;
+        atlas->TexHeight = height;
+        atlas->TexPixelsUseColors = useColors;
+        atlas->TexUvScale = uvScale;
+        atlas->TexUvWhitePixel = uvWhitePixel;
+        memcpy(atlas->TexUvLines, uvLines, sizeof(atlas->TexUvLines));
+        atlas->PackIdMouseCursors = packIdMouseCursors;
+        atlas->PackIdLines = packIdLines;
+
+        atlas->CustomRects.resize(rectCount);
+        for (int r = 0; r < rectCount; r++)
+        {
+            const unsigned char* entry = rects + r * (sizeof(ImFontAtlasCustomRect) + sizeof(int));
+            int fontIndex;
+            memcpy(&atlas->CustomRects[r], entry, sizeof(ImFontAtlasCustomRect));
+            memcpy(&fontIndex, entry + sizeof(ImFontAtlasCustomRect), sizeof(int));
+            atlas->CustomRects[r].Font = (fontIndex >= 0 && fontIndex < atlas->Fonts.Size) ? atlas->Fonts[fontIndex] : nullptr;
+        }
+
+        for (int f = 0; f < atlas->Fonts.Size; f++)
+        {
+            ImFont* font = atlas->Fonts[f];
+            font->ClearOutputData();
+            font->FontSize = fonts[f].FontSize;
+            font->Ascent = fonts[f].Ascent;
+            font->Descent = fonts[f].Descent;
+            font->MetricsTotalSurface = fonts[f].MetricsTotalSurface;
+            font->ContainerAtlas = atlas;
+
+            // the configs merged into this font, as the font builder would have linked them
+            font->ConfigData = nullptr;
+            font->ConfigDataCount = 0;
+            for (const ImFontConfig& config : atlas->ConfigData)
+            {
+                if (config.DstFont != font)
+                    continue;
+                if (font->ConfigData == nullptr)
+                    font->ConfigData = &config;
+                font->ConfigDataCount++;
+            }
+
+            font->Glyphs.resize(fonts[f].GlyphCount);
+            memcpy(font->Glyphs.Data, fonts[f].Glyphs, font->Glyphs.size_in_bytes());
+            font->BuildLookupTable();
+        }
+
+        atlas->TexReady = true;
+    }
+
+    UnloadFileData(data);
+    return valid;
+}
+
+// replaces rasterizing and packing the fonts with the cached result when the font setup matches
+static void BuildFontAtlas(ImFontAtlas* atlas, float dpiScale, bool highDPI)
+{
+    if (FontCachePath[0] == '\0' || atlas->TexPixelsAlpha8 != nullptr || atlas->TexPixelsRGBA32 != nullptr)
+        return;
+
+    uint64_t key = GetFontCacheKey(atlas, dpiScale, highDPI);
+    if (LoadFontCache(atlas, key))
+        return;
+
+    atlas->Build();
+    SaveFontCache(atlas, key);
+}
+
+// the CPU half of ReloadFonts: decompresses, rasterizes and packs the fonts. Only touches the atlas, so it may run on any thread
+static void BuildFonts(ImFontAtlas* atlas, float dpiScale, bool highDPI)
+{
+#ifdef RLIMGUI_SDF_FONTS
+    // the conversion works on a fresh build, so the atlas is always rebuilt from its fonts
+    atlas->ClearTexData();
+#endif
+
+    BuildFontAtlas(atlas, dpiScale, highDPI);
+
+#ifdef RLIMGUI_SDF_FONTS
+    ConvertAtlasToSDF(atlas);
+#endif
+
+    unsigned char* pixels = nullptr;
+    int width;
+    int height;
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+    atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+#else
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+#endif
+}
+
+// the GPU half of ReloadFonts, sends the built atlas to the font texture
+static void UploadFonts(void)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels = nullptr;
+
+    int width;
+    int height;
+    int bytesPerPixel;
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height, &bytesPerPixel);
+    const int format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+#else
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height, &bytesPerPixel);
+    const int format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+#endif
+    int pitch = width * bytesPerPixel;
+
+    Texture2D* fontTexture = FontTexture;
+    if (fontTexture && fontTexture->id != 0 && fontTexture->width == width && fontTexture->height == height && FontPixels.Size == pitch * height)
+    {
+        // same size, upload only the band of rows that differs from what the texture holds
+        int first = 0;
+        int last = height - 1;
+        while (first <= last && memcmp(FontPixels.Data + first * pitch, pixels + first * pitch, pitch) == 0)
+            first++;
+        while (last >= first && memcmp(FontPixels.Data + last * pitch, pixels + last * pitch, pitch) == 0)
+            last--;
+
+        if (first <= last)
+        {
+            int rows = last - first + 1;
+            UpdateTextureRec(*fontTexture, Rectangle{ 0, float(first), float(width), float(rows) }, pixels + first * pitch);
+            memcpy(FontPixels.Data + first * pitch, pixels + first * pitch, rows * pitch);
+        }
+        io.Fonts->TexID = (ImTextureID)fontTexture;
+        return;
+    }
+
+    if (fontTexture && fontTexture->id != 0)
+    {
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+        RemoveAlpha8Texture(fontTexture->id);
+#endif
+        UnloadTexture(*fontTexture);
+        MemFree(fontTexture);
+    }
+
+    // uploaded straight from ImGui's pixels, without going through a raylib Image
+    fontTexture = (Texture2D*)MemAlloc(sizeof(Texture2D));
+    fontTexture->id = rlLoadTexture(pixels, width, height, format, 1);
+    fontTexture->width = width;
+    fontTexture->height = height;
+    fontTexture->mipmaps = 1;
+    fontTexture->format = format;
+    io.Fonts->TexID = (ImTextureID)fontTexture;
+    FontTexture = fontTexture;
+
+#ifdef RLIMGUI_SDF_FONTS
+    SetSDFTexture(fontTexture->id);
+#elif defined(RLIMGUI_ALPHA8_FONT_ATLAS)
+    AddAlpha8Texture(fontTexture->id);
+#endif
+
+    FontPixels.resize(pitch * height);
+    memcpy(FontPixels.Data, pixels, pitch * height);
+}
+
+void ReloadFonts(void)
+{
+    BuildFonts(ImGui::GetIO().Fonts, GetFontDPIScale(), GetFontHighDPI());
+    UploadFonts();
+}
+#endif
+
+static const char* GetClipTextCallback(ImGuiContext*)
+{
+    return GetClipboardText();
+}
+
+static void SetClipTextCallback(ImGuiContext*, const char* text)
+{
+    SetClipboardText(text);
+}
+
+static void RecordInputEvent(const RecordedInputEvent& event)
+{
+    if (RecordFrameOffset < 0)
+        return;
+
+    // ImGui drops mouse moves to where the mouse already is and empty wheel events, so can the recording
+    if (event.Type == InputEventType::MousePos)
+    {
+        if (event.X == LastRecordedMousePos.X && event.Y == LastRecordedMousePos.Y)
+            return;
+        LastRecordedMousePos = event;
+    }
+    else if (event.Type == InputEventType::MouseWheel && event.X == 0 && event.Y == 0)
+    {
+        return;
+    }
+
+    int offset = RecordData.Size;
+    RecordData.resize(offset + int(sizeof(event)));
+    memcpy(RecordData.Data + offset, &event, sizeof(event));
+
+    // counted in the header of the frame being recorded
+    unsigned char* countData = RecordData.Data + RecordFrameOffset + offsetof(RecordedInputFrame, EventCount);
+    unsigned int count;
+    memcpy(&count, countData, sizeof(count));
+    count++;
+    memcpy(countData, &count, sizeof(count));
+}
+
+static RecordedInputEvent MakeInputEvent(InputEventType type, unsigned int code, bool down, float x = 0, float y = 0)
+{
+    return RecordedInputEvent{ type, (unsigned char)(down ? 1 : 0), 0, code, x, y };
+}
+
+// every event rlImGui feeds to ImGui goes through here, live or replayed, so a recording holds exactly what ImGui saw
+static void SubmitInputEvent(ImGuiIO& io, const RecordedInputEvent& event)
+{
+    switch (event.Type)
+    {
+    case InputEventType::Focus: io.AddFocusEvent(event.Down != 0); break;
+    case InputEventType::Key: io.AddKeyEvent(ImGuiKey(event.Code), event.Down != 0); break;
+    case InputEventType::KeyAnalog: io.AddKeyAnalogEvent(ImGuiKey(event.Code), event.Down != 0, event.X); break;
+    case InputEventType::Char: io.AddInputCharacter(event.Code); break;
+    case InputEventType::MousePos: io.AddMousePosEvent(event.X, event.Y); break;
+    case InputEventType::MouseButton: io.AddMouseButtonEvent(int(event.Code), event.Down != 0); break;
+    case InputEventType::MouseWheel: io.AddMouseWheelEvent(event.X, event.Y); break;
+    }
+
+    if (Recording)
+        RecordInputEvent(event);
+}
+
+static void BeginRecordFrame(const ImGuiIO& io)
+{
+    RecordedInputFrame frame = { RecordFrameCount++, 0, io.DeltaTime, io.DisplaySize.x, io.DisplaySize.y };
+
+    RecordFrameOffset = RecordData.Size;
+    RecordData.resize(RecordFrameOffset + int(sizeof(frame)));
+    memcpy(RecordData.Data + RecordFrameOffset, &frame, sizeof(frame));
+}
+
+static void BeginReplayFrame(ImGuiIO& io)
+{
+    memcpy(&ReplayFrame, ReplayData.Data + ReplayOffset, sizeof(ReplayFrame));
+    ReplayOffset += int(sizeof(ReplayFrame));
+
+    io.DeltaTime = ReplayFrame.DeltaTime;
+    io.DisplaySize = ImVec2(ReplayFrame.DisplayWidth, ReplayFrame.DisplayHeight);
+}
+
+// ImGui and the live input tracking start over from no keys down, before and after a replay
+static void ResetInputState(void)
+{
+    HeldKeys.clear();
+#ifdef RLIMGUI_GLFW_INPUT
+    MouseEventQueue.clear();
+    ForwardedMouseMoves.clear();
+#endif
+    LastControlPressed = false;
+    LastShiftPressed = false;
+    LastAltPressed = false;
+    LastSuperPressed = false;
+
+    if (ImGui::GetCurrentContext() == nullptr)
+        return;
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.ClearEventsQueue();
+    io.ClearInputKeys();
+    for (int button = 0; button < ImGuiMouseButton_COUNT; button++)
+        io.AddMouseButtonEvent(button, false);
+}
+
+static void EndReplay(void)
+{
+    Replaying = false;
+    ReplayData.clear();
+    ReplayOffset = 0;
+    ReplayFrame = RecordedInputFrame{ 0 };
+}
+
+// feeds the events of the frame BeginReplayFrame started instead of reading raylib input
+static void ReplayInputEvents(ImGuiIO& io)
+{
+    for (unsigned int i = 0; i < ReplayFrame.EventCount; i++)
+    {
+        RecordedInputEvent event;
+        memcpy(&event, ReplayData.Data + ReplayOffset, sizeof(event));
+        ReplayOffset += int(sizeof(event));
+
+        SubmitInputEvent(io, event);
+    }
+    ReplayFrame.EventCount = 0;
+
+    if (ReplayOffset >= ReplayData.Size)
+    {
+        TraceLog(LOG_INFO, "RLIMGUI: Replay finished after %u frames", ReplayFrame.Frame + 1);
+        EndReplay();
+
+        // the last replayed events are still queued, live input takes over from a clean state next frame
+        InputResetPending = true;
+    }
+}
+
+#ifdef RLIMGUI_GLFW_INPUT
+static void StampRawInput(void)
+{
+    if (RawInputTime < 0)
+        RawInputTime = GetTime();
+    RawInputEvents++;
+}
+
+static void QueueMouseEvent(const RecordedInputEvent& event)
+{
+    if (!UseMouseEventQueue)
+        return;
+
+    // a frame that takes very long keeps every button transition, but only the latest of consecutive moves
+    QueuedMouseEvent queued = { event, GetTime() };
+    if (MouseEventQueue.Size >= MouseEventQueueLimit && event.Type == InputEventType::MousePos && MouseEventQueue.back().Event.Type == InputEventType::MousePos)
+        MouseEventQueue.back() = queued;
+    else
+        MouseEventQueue.push_back(queued);
+}
+
+// the position as raylib reports it, with SetMouseOffset and SetMouseScale applied
+static void QueueMousePosition(void)
+{
+    Vector2 position = GetMousePosition();
+    QueueMouseEvent(MakeInputEvent(InputEventType::MousePos, 0, false, position.x, position.y));
+}
+
+// raylib's callbacks run first, so its input state is up to date when the event is stamped
+static void RawCursorPosCallback(GLFWwindow* window, double x, double y)
+{
+    if (PrevCursorPosCallback)
+        PrevCursorPosCallback(window, x, y);
+
+    RawCursorX = x;
+    RawCursorY = y;
+    StampRawInput();
+    QueueMousePosition();
+}
+
+static void RawMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    if (PrevMouseButtonCallback)
+        PrevMouseButtonCallback(window, button, action, mods);
+    StampRawInput();
+
+    // GLFW buttons are raylib's MouseButton values, forward and back are ImGui's extra buttons
+    int imGuiMouse = -1;
+    switch (button)
+    {
+    case MOUSE_BUTTON_LEFT: imGuiMouse = ImGuiMouseButton_Left; break;
+    case MOUSE_BUTTON_RIGHT: imGuiMouse = ImGuiMouseButton_Right; break;
+    case MOUSE_BUTTON_MIDDLE: imGuiMouse = ImGuiMouseButton_Middle; break;
+    case MOUSE_BUTTON_FORWARD: imGuiMouse = ImGuiMouseButton_Middle + 1; break;
+    case MOUSE_BUTTON_BACK: imGuiMouse = ImGuiMouseButton_Middle + 2; break;
+    default: break;
+    }
+
+    if (imGuiMouse >= 0 && (action == GLFW_PRESS || action == GLFW_RELEASE))
+        QueueMouseEvent(MakeInputEvent(InputEventType::MouseButton, imGuiMouse, action == GLFW_PRESS));
+}
+
+static void RawScrollCallback(GLFWwindow* window, double x, double y)
+{
+    if (PrevScrollCallback)
+        PrevScrollCallback(window, x, y);
+    StampRawInput();
+}
+
+static void RawKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (PrevKeyCallback)
+        PrevKeyCallback(window, key, scancode, action, mods);
+    StampRawInput();
+}
+
+static void RawCharCallback(GLFWwindow* window, unsigned int codepoint)
+{
+    if (PrevCharCallback)
+        PrevCharCallback(window, codepoint);
+    StampRawInput();
+}
+
+// chained onto raylib's callbacks once the window exists, the window's context is current on the thread that polls input
+static void InstallInputCallbacks(void)
+{
+    if (InputWindow != nullptr || !IsWindowReady())
+        return;
+
+    InputWindow = glfwGetCurrentContext();
+    if (InputWindow == nullptr)
+        return;
+
+    glfwGetCursorPos(InputWindow, &RawCursorX, &RawCursorY);
+
+    PrevCursorPosCallback = glfwSetCursorPosCallback(InputWindow, RawCursorPosCallback);
+    PrevMouseButtonCallback = glfwSetMouseButtonCallback(InputWindow, RawMouseButtonCallback);
+    PrevScrollCallback = glfwSetScrollCallback(InputWindow, RawScrollCallback);
+    PrevKeyCallback = glfwSetKeyCallback(InputWindow, RawKeyCallback);
+    PrevCharCallback = glfwSetCharCallback(InputWindow, RawCharCallback);
+}
+
+// puts raylib's callbacks back, unless something chained onto ours since
+template<typename Callback>
+static void RestoreInputCallback(Callback (*setCallback)(GLFWwindow*, Callback), Callback ours, Callback previous)
+{
+    Callback current = setCallback(InputWindow, previous);
+    if (current != ours)
+        setCallback(InputWindow, current);
+}
+
+static void UninstallInputCallbacks(void)
+{
+    // the callbacks went away with the window if it was already closed
+    if (InputWindow != nullptr && IsWindowReady())
+    {
+
+        RestoreInputCallback(glfwSetCursorPosCallback, (GLFWcursorposfun)RawCursorPosCallback, PrevCursorPosCallback);
+        RestoreInputCallback(glfwSetMouseButtonCallback, (GLFWmousebuttonfun)RawMouseButtonCallback, PrevMouseButtonCallback);
+        RestoreInputCallback(glfwSetScrollCallback, (GLFWscrollfun)RawScrollCallback, PrevScrollCallback);
+        RestoreInputCallback(glfwSetKeyCallback, (GLFWkeyfun)RawKeyCallback, PrevKeyCallback);
+        RestoreInputCallback(glfwSetCharCallback, (GLFWcharfun)RawCharCallback, PrevCharCallback);
+    }
+
+    InputWindow = nullptr;
+    RawInputTime = -1;
+    RawInputEvents = 0;
+    MouseEventQueue.clear();
+    ForwardedMouseMoves.clear();
+}
+
+// forwards the queued mouse events, false when the queue is not in use and the mouse state has to be polled
+static bool ForwardMouseEventQueue(ImGuiIO& io)
+{
+    ForwardedMouseMoves.clear();
+    if (!UseMouseEventQueue || InputWindow == nullptr)
+        return false;
+
+    for (const QueuedMouseEvent& queued : MouseEventQueue)
+    {
+        if (queued.Event.Type == InputEventType::MousePos)
+        {
+            if (io.WantSetMousePos)
+                continue;
+            ForwardedMouseMoves.push_back(queued);
+        }
+        SubmitInputEvent(io, queued.Event);
+    }
+    MouseEventQueue.clear();
+
+    return true;
+}
+#endif
+
+// starts the latency measurement of a frame when ImGui_ImplRaylib_ProcessEvents reads input
+static void SampleInputTime(double sampleTime)
+{
+    FrameSampleTime = sampleTime;
+    FrameProcessTime = sampleTime;
+    FrameInputTime = sampleTime;
+    FrameRawInputEvents = 0;
+
+#ifdef RLIMGUI_GLFW_INPUT
+    if (RawInputTime >= 0)
+        FrameInputTime = RawInputTime;
+    FrameRawInputEvents = RawInputEvents;
+
+    RawInputTime = -1;
+    RawInputEvents = 0;
+#endif
+}
+
+// the position ImGui gets, read from the OS in low latency mode rather than from the state raylib polled last frame
+static Vector2 GetSampledMousePosition(void)
+{
+    Vector2 position = GetMousePosition();
+
+#ifdef RLIMGUI_GLFW_INPUT
+    // only when raylib reports the raw cursor, without SetMouseOffset or SetMouseScale applied
+    if (LowLatencyMouse && InputWindow != nullptr)
+    {
+        if (position.x == float(RawCursorX) && position.y == float(RawCursorY))
+        {
+            double x = 0, y = 0;
+            glfwGetCursorPos(InputWindow, &x, &y);
+            position = Vector2{ float(x), float(y) };
+        }
+    }
+#endif
+
+    return position;
+}
+
+static void ImGuiNewFrame(float deltaTime)
+{
+    ImGuiIO& io = ImGui::GetIO();
+
+    Vector2 resolutionScale = GetWindowScaleDPI();
+
+#ifndef PLATFORM_DRM
+    if (IsWindowFullscreen())
+    {
+        int monitor = GetCurrentMonitor();
+        io.DisplaySize.x = float(GetMonitorWidth(monitor));
+        io.DisplaySize.y = float(GetMonitorHeight(monitor));
+    }
+    else
+    {
+        io.DisplaySize.x = float(GetScreenWidth());
+        io.DisplaySize.y = float(GetScreenHeight());
+    }
+
+#if !defined(__APPLE__)
+    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
+        resolutionScale = Vector2{ 1,1 };
+#endif
+#else
+    io.DisplaySize.x = float(GetScreenWidth());
+    io.DisplaySize.y = float(GetScreenHeight());
+#endif
+
+    io.DisplayFramebufferScale = ImVec2(resolutionScale.x, resolutionScale.y);
+
+#ifdef RLIMGUI_SDF_FONTS
+    // follows DPI changes without rebaking, the distance field stays sharp at any scale
+    if (SDFDefaultFont != nullptr && io.Fonts->Fonts.contains(SDFDefaultFont))
+    {
+        SDFDefaultFont->Scale = SDFDefaultFontScale;
+#if !defined(__APPLE__)
+        if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
+            SDFDefaultFont->Scale *= GetWindowScaleDPI().y;
+#endif
+    }
+#endif
+
+    if (deltaTime <= 0)
+        deltaTime = 0.001f;
+
+    io.DeltaTime = deltaTime;
+
+    // a replayed frame takes the recorded frame time and display size, however fast it is played back
+    if (Replaying)
+        BeginReplayFrame(io);
+    if (Recording)
+        BeginRecordFrame(io);
+
+    if (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_HasMouseCursors)
+    {
+        if ((io.ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange) == 0)
+        {
+            ImGuiMouseCursor imgui_cursor = ImGui::GetMouseCursor();
+            if (imgui_cursor != CurrentMouseCursor || io.MouseDrawCursor)
+            {
+                CurrentMouseCursor = imgui_cursor;
+                if (io.MouseDrawCursor || imgui_cursor == ImGuiMouseCursor_None)
+                {
+                    HideCursor();
+                }
+                else
+                {
+                    ShowCursor();
+
+                    if (!(io.ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange))
+                    {
+                        SetMouseCursor((imgui_cursor > -1 && imgui_cursor < ImGuiMouseCursor_COUNT) ? MouseCursorMap[imgui_cursor] : MOUSE_CURSOR_DEFAULT);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void ImGuiTriangleVert(const ImDrawVert& idx_vert)
+{
+    const Color* c;
+    c = (const Color*)&idx_vert.col;
+    rlColor4ub(c->r, c->g, c->b, c->a);
+    rlTexCoord2f(idx_vert.uv.x, idx_vert.uv.y);
+    rlVertex2f(idx_vert.pos.x, idx_vert.pos.y);
+}
+
+// Index is ImDrawIdx, so the emitter is specialized for 16 or 32 bit indices at compile time.
+// vertices already points at the command's VtxOffset, indices at its IdxOffset.
+template <typename Index>
+static void ImGuiRenderTriangles(unsigned int count, const Index* indices, const ImDrawVert* vertices, unsigned int textureId)
+{
+    if (count < 3)
+        return;
+
+    rlBegin(RL_TRIANGLES);
+
+    // commands share one rlgl batch, so the texture is only set when it differs from the previous command's.
+    // A flush resets rlgl's texture, RenderDrawDataImmediate forgets the cached id whenever it flushes
+    if (textureId != StateCache.TextureId)
+    {
+        rlSetTexture(textureId);
+        StateCache.TextureId = textureId;
+        RenderStats.textureSwitches++;
+    }
+    else
+    {
+        RenderStats.texturesSkipped++;
+    }
+
+    for (unsigned int i = 0; i <= (count - 3); i += 3)
+    {
+        ImGuiTriangleVert(vertices[indices[i]]);
+        ImGuiTriangleVert(vertices[indices[i + 1]]);
+        ImGuiTriangleVert(vertices[indices[i + 2]]);
+    }
+    rlEnd();
+}
+
+// the scale from ImGui display units to pixels of the window framebuffer
+static ImVec2 GetFramebufferScale(const ImDrawData* draw_data)
+{
+#if !defined(__APPLE__)
+    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
+        return ImVec2(1, 1);
+#endif
+    return draw_data->FramebufferScale;
+}
+
+static void BeginStateCache(const ImDrawData* draw_data, ImVec2 framebufferScale)
+{
+    StateCache = RenderStateCache();
+    StateCache.DisplayPos = draw_data->DisplayPos;
+    StateCache.DisplaySize = draw_data->DisplaySize;
+    StateCache.FramebufferScale = framebufferScale;
+}
+
+static void InvalidateStateCache(void)
+{
+    StateCache.ScissorValid = false;
+    StateCache.TextureId = 0;
+    StateCache.ShaderId = 0;
+    StateCache.BlendAndCullValid = false;
+}
+
+static void ApplyBlendAndCull(void)
+{
+    if (StateCache.BlendAndCullValid)
+        return;
+
+    rlEnableColorBlend();
+    rlDisableBackfaceCulling();
+    StateCache.BlendAndCullValid = true;
+}
+
+// converts a clip rect to a scissor rect in framebuffer pixels, returns false when none of it is on screen
+static bool ClipRectToScissor(const ImVec4& clipRect, int scissor[4])
+{
+    ImVec2 clipMin(std::max(clipRect.x - StateCache.DisplayPos.x, 0.0f), std::max(clipRect.y - StateCache.DisplayPos.y, 0.0f));
+    ImVec2 clipMax(std::min(clipRect.z - StateCache.DisplayPos.x, StateCache.DisplaySize.x), std::min(clipRect.w - StateCache.DisplayPos.y, StateCache.DisplaySize.y));
+
+    if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y)
+        return false;
+
+    // GL scissor rects start at the bottom left
+    ImVec2 scale = StateCache.FramebufferScale;
+    scissor[0] = (int)(clipMin.x * scale.x);
+    scissor[1] = (int)((StateCache.DisplaySize.y - clipMax.y) * scale.y);
+    scissor[2] = (int)((clipMax.x - clipMin.x) * scale.x);
+    scissor[3] = (int)((clipMax.y - clipMin.y) * scale.y);
+
+    return scissor[2] > 0 && scissor[3] > 0;
+}
+
+// commands with no geometry or a clip rect that is empty or off the framebuffer never reach the GPU.
+// scissor receives the clip rect in framebuffer pixels, all zero when none of it is on screen
+static bool IsCommandCulled(const ImDrawCmd& cmd, int scissor[4])
+{
+    if (cmd.UserCallback == nullptr && cmd.ElemCount == 0)
+        return true;
+
+    if (ClipRectToScissor(cmd.ClipRect, scissor))
+        return false;
+
+    memset(scissor, 0, sizeof(int) * 4);
+    return cmd.UserCallback == nullptr;
+}
+
+static bool ScissorChanged(const int scissor[4])
+{
+    return !StateCache.ScissorValid || memcmp(StateCache.Scissor, scissor, sizeof(StateCache.Scissor)) != 0;
+}
+
+static void ApplyScissor(const int scissor[4])
+{
+    if (!StateCache.ScissorValid)
+        rlEnableScissorTest();
+
+    rlScissor(scissor[0], scissor[1], scissor[2], scissor[3]);
+
+    memcpy(StateCache.Scissor, scissor, sizeof(StateCache.Scissor));
+    StateCache.ScissorValid = true;
+    RenderStats.scissorChanges++;
+}
+
+static unsigned int GetCommandTextureId(const ImDrawCmd& cmd)
+{
+    Texture* texture = (Texture*)cmd.GetTexID();
+    return (texture == nullptr) ? rlGetTextureIdDefault() : texture->id;
+}
+
+// coalesces adjacent commands of a draw list that can be drawn with a single draw into DrawBatches
+static void MergeDrawCommands(const ImDrawList* commandList)
+{
+    DrawBatches.resize(0);
+
+    for (const auto& cmd : commandList->CmdBuffer)
+    {
+        RenderStats.drawCommands++;
+
+        DrawBatch batch;
+        if (IsCommandCulled(cmd, batch.Scissor))
+        {
+            RenderStats.culledCommands++;
+            continue;
+        }
+
+        batch.Command = &cmd;
+        batch.IdxOffset = cmd.IdxOffset;
+        batch.ElemCount = cmd.ElemCount;
+
+        if (!DrawBatches.empty())
+        {
+            DrawBatch& last = DrawBatches.back();
+            const ImDrawCmd* prev = last.Command;
+
+            if (cmd.UserCallback == nullptr && prev->UserCallback == nullptr
+                && cmd.GetTexID() == prev->GetTexID()
+                && cmd.VtxOffset == prev->VtxOffset
+                && memcmp(batch.Scissor, last.Scissor, sizeof(batch.Scissor)) == 0
+                && last.IdxOffset + last.ElemCount == cmd.IdxOffset)
+            {
+                last.ElemCount += cmd.ElemCount;
+                RenderStats.mergedCommands++;
+                continue;
+            }
+        }
+
+        DrawBatches.push_back(batch);
+    }
+}
+
+static void RenderDrawDataImmediate(ImDrawData* draw_data)
+{
+    // rlgl splits texture changes inside one batch on its own, only scissor, blend and cull state
+    // (which are immediate GL state) and user callbacks need the pending geometry flushed first
+    bool pending = false;
+
+#ifndef RLIMGUI_TEXTURE_SHADERS
+    // everything is drawn with rlgl's current shader, made the one from rlImGuiSetShader if there is one
+    if (BaseShader.id != 0)
+        rlSetShader(BaseShader.id, BaseShader.locs);
+#endif
+
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists[l];
+
+        MergeDrawCommands(commandList);
+
+        for (const auto& batch : DrawBatches)
+        {
+            const ImDrawCmd& cmd = *batch.Command;
+
+            if (cmd.UserCallback != nullptr || ScissorChanged(batch.Scissor))
+            {
+                if (pending)
+                {
+                    rlDrawRenderBatchActive();
+                    RenderStats.batchFlushes++;
+                    StateCache.TextureId = 0;
+                    pending = false;
+                }
+
+                ApplyScissor(batch.Scissor);
+            }
+            else
+            {
+                RenderStats.scissorsSkipped++;
+            }
+
+            if (cmd.UserCallback != nullptr)
+            {
+                if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                    cmd.UserCallback(commandList, &cmd);
+
+                InvalidateStateCache();
+                continue;
+            }
+
+            ApplyBlendAndCull();
+
+            unsigned int textureId = GetCommandTextureId(cmd);
+
+#ifdef RLIMGUI_TEXTURE_SHADERS
+            // rlSetShader flushes the batch when the shader changes
+            Shader shader = GetTextureShader(textureId);
+            if (shader.id != StateCache.ShaderId)
+            {
+                if (pending && StateCache.ShaderId != 0)
+                    RenderStats.batchFlushes++;
+
+                rlSetShader(shader.id, shader.locs);
+                StateCache.ShaderId = shader.id;
+                StateCache.TextureId = 0;
+                pending = false;
+            }
+#endif
+
+            ImGuiRenderTriangles(batch.ElemCount, commandList->IdxBuffer.Data + batch.IdxOffset, commandList->VtxBuffer.Data + cmd.VtxOffset, textureId);
+            pending = true;
+        }
+    }
+
+    if (pending)
+    {
+        rlDrawRenderBatchActive();
+        RenderStats.batchFlushes++;
+    }
+
+#ifdef RLIMGUI_TEXTURE_SHADERS
+    Shader shader = GetBaseShader();
+    rlSetShader(shader.id, shader.locs);
+#endif
+}
+
+#ifdef RLIMGUI_RETAINED_RENDERER
+static void ReserveGPUBuffers(int vertexCount, int indexCount)
+{
+    if (GPUBuffers.VaoId == 0)
+        GPUBuffers.VaoId = rlLoadVertexArray();
+
+    // bind our vertex array first so a new index buffer is never attached to someone else's
+    rlEnableVertexArray(GPUBuffers.VaoId);
+
+    // grow geometrically so a frame with a few more widgets does not reallocate every time
+    if (vertexCount > GPUBuffers.VertexCapacity)
+    {
+        if (GPUBuffers.VboId != 0)
+            rlUnloadVertexBuffer(GPUBuffers.VboId);
+
+        GPUBuffers.VertexCapacity = std::max(vertexCount, GPUBuffers.VertexCapacity * 2);
+        GPUBuffers.VboId = rlLoadVertexBuffer(nullptr, GPUBuffers.VertexCapacity * (int)sizeof(ImDrawVert), true);
+    }
+
+    if (indexCount > GPUBuffers.IndexCapacity)
+    {
+        if (GPUBuffers.IboId != 0)
+            rlUnloadVertexBuffer(GPUBuffers.IboId);
+
+        GPUBuffers.IndexCapacity = std::max(indexCount, GPUBuffers.IndexCapacity * 2);
+        GPUBuffers.IboId = rlLoadVertexBufferElement(nullptr, GPUBuffers.IndexCapacity * (int)sizeof(ImDrawIdx), true);
+    }
+}
+
+// whether the index buffer can be drawn as is, loads glDrawElements the first time with 32 bit ImDrawIdx
+static bool UseIndexedDraws(void)
+{
+    if constexpr (sizeof(ImDrawIdx) == sizeof(unsigned short))
+        return true;
+
+#ifdef RLIMGUI_DRAW_ELEMENTS_32
+    if (DrawElements32 == nullptr)
+        DrawElements32 = (DrawElementsProc)glfwGetProcAddress("glDrawElements");
+    return DrawElements32 != nullptr;
+#else
+    return false;
+#endif
+}
+
+// draws count indices from the bound index buffer, starting at index offset
+static void DrawIndexed(int offset, int count)
+{
+    if constexpr (sizeof(ImDrawIdx) == sizeof(unsigned short))
+    {
+        rlDrawVertexArrayElements(offset, count, nullptr);
+    }
+    else
+    {
+#ifdef RLIMGUI_DRAW_ELEMENTS_32
+        const unsigned int triangles = 0x0004;      // GL_TRIANGLES
+        const unsigned int unsignedInt = 0x1405;    // GL_UNSIGNED_INT
+        DrawElements32(triangles, count, unsignedInt, (const void*)(uintptr_t(offset) * sizeof(ImDrawIdx)));
+#else
+        (void)offset;
+        (void)count;
+#endif
+    }
+}
+
+static void UnloadGPUBuffers(void)
+{
+    if (GPUBuffers.VboId != 0)
+        rlUnloadVertexBuffer(GPUBuffers.VboId);
+
+    if (GPUBuffers.IboId != 0)
+        rlUnloadVertexBuffer(GPUBuffers.IboId);
+
+    if (GPUBuffers.VaoId != 0)
+        rlUnloadVertexArray(GPUBuffers.VaoId);
+
+    GPUBuffers = RetainedBuffers();
+}
+
+// points the default shader's attributes at the vertex buffer, starting at the given vertex
+static void SetVertexLayout(unsigned int baseVertex)
+{
+    const int* locs = rlGetShaderLocsDefault();
+    const int stride = (int)sizeof(ImDrawVert);
+    const int base = (int)baseVertex * stride;
+
+    if (locs[RL_SHADER_LOC_VERTEX_POSITION] >= 0)
+    {
+        rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_POSITION], 2, RL_FLOAT, false, stride, base + (int)offsetof(ImDrawVert, pos));
+        rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_POSITION]);
+    }
+
+    if (locs[RL_SHADER_LOC_VERTEX_TEXCOORD01] >= 0)
+    {
+        rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_FLOAT, false, stride, base + (int)offsetof(ImDrawVert, uv));
+        rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+    }
+
+    if (locs[RL_SHADER_LOC_VERTEX_COLOR] >= 0)
+    {
+        rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_COLOR], 4, RL_UNSIGNED_BYTE, true, stride, base + (int)offsetof(ImDrawVert, col));
+        rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_COLOR]);
+    }
+}
+
+static void BindTexture(unsigned int textureId)
+{
+    if (textureId == StateCache.TextureId)
+    {
+        RenderStats.texturesSkipped++;
+        return;
+    }
+
+    rlEnableTexture(textureId);
+    StateCache.TextureId = textureId;
+    RenderStats.textureSwitches++;
+}
+
+// rlgl binds the same attribute locations for every shader it loads, so the vertex layout stays valid across shaders
+static void UseRetainedShader(unsigned int shaderId, const int* locs)
+{
+    if (shaderId == StateCache.ShaderId)
+        return;
+
+    rlEnableShader(shaderId);
+    StateCache.ShaderId = shaderId;
+
+    // use whatever transform raylib is currently drawing with, same as the immediate mode path
+    Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    rlSetUniformMatrix(locs[RL_SHADER_LOC_MATRIX_MVP], mvp);
+
+    float diffuse[4] = { 1, 1, 1, 1 };
+    rlSetUniform(locs[RL_SHADER_LOC_COLOR_DIFFUSE], diffuse, RL_SHADER_UNIFORM_VEC4, 1);
+
+    int textureSlot = 0;
+    rlSetUniform(locs[RL_SHADER_LOC_MAP_DIFFUSE], &textureSlot, RL_SHADER_UNIFORM_INT, 1);
+}
+
+static void BindTextureAndShader(unsigned int textureId)
+{
+#ifdef RLIMGUI_TEXTURE_SHADERS
+    Shader shader = GetTextureShader(textureId);
+    UseRetainedShader(shader.id, shader.locs);
+#endif
+
+    BindTexture(textureId);
+}
+
+static void SetupRetainedRenderState(void)
+{
+    Shader shader = GetBaseShader();
+    UseRetainedShader(shader.id, shader.locs);
+    rlActiveTextureSlot(0);
+
+    rlEnableVertexArray(GPUBuffers.VaoId);
+    rlEnableVertexBuffer(GPUBuffers.VboId);
+    rlEnableVertexBufferElement(GPUBuffers.IboId);
+}
+
+static void RenderDrawDataRetained(ImDrawData* draw_data)
+{
+    if (draw_data->TotalVtxCount <= 0 || draw_data->TotalIdxCount <= 0)
+        return;
+
+    const bool indexedDraws = UseIndexedDraws();
+    if (indexedDraws)
+    {
+        ReserveGPUBuffers(draw_data->TotalVtxCount, draw_data->TotalIdxCount);
+
+        // upload every list back to back, once per frame
+        int vertexOffset = 0;
+        int indexOffset = 0;
+        for (int l = 0; l < draw_data->CmdListsCount; ++l)
+        {
+            const ImDrawList* commandList = draw_data->CmdLists[l];
+
+            rlUpdateVertexBuffer(GPUBuffers.VboId, commandList->VtxBuffer.Data, commandList->VtxBuffer.size_in_bytes(), vertexOffset * (int)sizeof(ImDrawVert));
+            rlUpdateVertexBufferElements(GPUBuffers.IboId, commandList->IdxBuffer.Data, commandList->IdxBuffer.size_in_bytes(), indexOffset * (int)sizeof(ImDrawIdx));
+
+            vertexOffset += commandList->VtxBuffer.Size;
+            indexOffset += commandList->IdxBuffer.Size;
+        }
+    }
+    else
+    {
+        // expand every drawn command in submission order, callbacks carry no geometry
+        DeindexedVertices.resize(draw_data->TotalIdxCount);
+        ImDrawVert* out = DeindexedVertices.Data;
+        for (int l = 0; l < draw_data->CmdListsCount; ++l)
+        {
+            const ImDrawList* commandList = draw_data->CmdLists[l];
+
+            for (const auto& cmd : commandList->CmdBuffer)
+            {
+                int scissor[4];
+                if (cmd.UserCallback != nullptr || IsCommandCulled(cmd, scissor))
+                    continue;
+
+                const ImDrawIdx* indices = commandList->IdxBuffer.Data + cmd.IdxOffset;
+                const ImDrawVert* vertices = commandList->VtxBuffer.Data + cmd.VtxOffset;
+                DeindexVertices(out, vertices, indices, cmd.ElemCount);
+                out += cmd.ElemCount;
+            }
+        }
+
+        int vertexCount = (int)(out - DeindexedVertices.Data);
+        ReserveGPUBuffers(vertexCount, 0);
+        rlUpdateVertexBuffer(GPUBuffers.VboId, DeindexedVertices.Data, vertexCount * (int)sizeof(ImDrawVert), 0);
+    }
+
+    SetupRetainedRenderState();
+
+    // the vertex attributes are re-pointed whenever the base vertex changes, which is how
+    // ImDrawCmd::VtxOffset is honored without glDrawElementsBaseVertex
+    unsigned int baseVertex = 0;
+    SetVertexLayout(baseVertex);
+
+    int vertexOffset = 0;
+    int indexOffset = 0;
+    int deindexedOffset = 0;
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists[l];
+
+        MergeDrawCommands(commandList);
+
+        for (const auto& batch : DrawBatches)
+        {
+            const ImDrawCmd& cmd = *batch.Command;
+
+            if (cmd.UserCallback != nullptr || ScissorChanged(batch.Scissor))
+                ApplyScissor(batch.Scissor);
+            else
+                RenderStats.scissorsSkipped++;
+
+            if (cmd.UserCallback != nullptr)
+            {
+                if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                    cmd.UserCallback(commandList, &cmd);
+
+                // the callback may have drawn with rlgl, so flush it and take the GL state back
+                rlDrawRenderBatchActive();
+                RenderStats.batchFlushes++;
+                InvalidateStateCache();
+                SetupRetainedRenderState();
+                SetVertexLayout(baseVertex);
+                continue;
+            }
+
+            ApplyBlendAndCull();
+
+            if (indexedDraws)
+            {
+                if (batch.ElemCount < 3)
+                    continue;
+
+                if (baseVertex != vertexOffset + cmd.VtxOffset)
+                {
+                    baseVertex = vertexOffset + cmd.VtxOffset;
+                    SetVertexLayout(baseVertex);
+                }
+
+                BindTextureAndShader(GetCommandTextureId(cmd));
+
+                DrawIndexed(indexOffset + (int)batch.IdxOffset, (int)batch.ElemCount);
+                RenderStats.batchFlushes++;
+            }
+            else
+            {
+                int first = deindexedOffset;
+                deindexedOffset += (int)batch.ElemCount;
+
+                if (batch.ElemCount < 3)
+                    continue;
+
+                BindTextureAndShader(GetCommandTextureId(cmd));
+
+                rlDrawVertexArray(first, (int)batch.ElemCount);
+                RenderStats.batchFlushes++;
+            }
+        }
+
+        vertexOffset += commandList->VtxBuffer.Size;
+        indexOffset += commandList->IdxBuffer.Size;
+    }
+
+    rlDisableTexture();
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableShader();
+}
+#endif
+
+// draws the draw data into the current raylib target, framebufferScale maps ImGui display units to its pixels
+static void SubmitDrawData(ImDrawData* draw_data, ImVec2 framebufferScale)
+{
+    double start = GetTime();
+
+    RenderStats = rlImGuiRenderStats{ 0 };
+    RenderStats.drawLists = draw_data->CmdListsCount;
+    RenderStats.vertices = draw_data->TotalVtxCount;
+    RenderStats.indices = draw_data->TotalIdxCount;
+
+    rlDrawRenderBatchActive();
+    BeginStateCache(draw_data, framebufferScale);
+
+#ifdef RLIMGUI_DYNAMIC_TEXTURES
+    UpdateTextures(draw_data->Textures);
+#endif
+
+#ifdef RLIMGUI_RETAINED_RENDERER
+    RenderDrawDataRetained(draw_data);
+#else
+    RenderDrawDataImmediate(draw_data);
+#endif
+
+    rlSetTexture(0);
+    rlDisableScissorTest();
+    rlEnableBackfaceCulling();
+
+    // what flushing after every command, as this backend used to, would have cost
+    RenderStats.flushesSaved = std::max(0, RenderStats.drawCommands - RenderStats.batchFlushes);
+
+    RenderStats.renderTime = float((GetTime() - start) * 1000.0);
+}
+
+// completes RenderStats for the frame and appends it to the history
+static float MillisecondsBetween(double from, double to)
+{
+    return float((to - from) * 1000.0);
+}
+
+static void RecordRenderStats(void)
+{
+    // called right after the draw data was submitted
+    double submitTime = GetTime();
+    RenderStats.rawInputEvents = FrameRawInputEvents;
+    RenderStats.inputToSample = MillisecondsBetween(FrameInputTime, FrameSampleTime);
+    RenderStats.inputToProcess = MillisecondsBetween(FrameInputTime, FrameProcessTime);
+    RenderStats.inputToSubmit = MillisecondsBetween(FrameInputTime, submitTime);
+    RenderStats.inputToPresent = 0;
+    PresentInputTime = FrameInputTime;
+    PresentPending = true;
+
+    RenderStats.processEventsTime = ProcessEventsTime;
+    RenderStats.totalFramesSkipped = TotalFramesSkipped;
+    RenderStats.cachedLayerReuses = UILayerReuses;
+
+    StatsHistory[StatsHistoryNext] = RenderStats;
+    StatsHistoryNext = (StatsHistoryNext + 1) % RLIMGUI_STATS_HISTORY;
+    StatsHistoryCount = std::min(StatsHistoryCount + 1, RLIMGUI_STATS_HISTORY);
+}
+
+// the UI is drawn into UILayer only when it changed, and the layer is composited over the scene every frame
+static void RenderCachedLayer(ImDrawData* draw_data, uint64_t hash)
+{
+    double start = GetTime();
+
+    ImVec2 scale = GetFramebufferScale(draw_data);
+    int width = (int)(draw_data->DisplaySize.x * scale.x);
+    int height = (int)(draw_data->DisplaySize.y * scale.y);
+    if (width <= 0 || height <= 0)
+        return;
+
+    if (UILayer.id == 0 || UILayer.texture.width != width || UILayer.texture.height != height)
+    {
+        if (UILayer.id != 0)
+            UnloadRenderTexture(UILayer);
+
+        UILayer = LoadRenderTexture(width, height);
+        UILayerValid = false;
+    }
+
+    if (!UILayerValid || hash != UILayerHash)
+    {
+        BeginTextureMode(UILayer);
+        ClearBackground(BLANK);
+
+        // ImGui works in display units, the layer is sized in framebuffer pixels
+        rlMatrixMode(RL_PROJECTION);
+        rlLoadIdentity();
+        rlOrtho(draw_data->DisplayPos.x, draw_data->DisplayPos.x + draw_data->DisplaySize.x, draw_data->DisplayPos.y + draw_data->DisplaySize.y, draw_data->DisplayPos.y, 0, 1);
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
+
+        // keep the layer premultiplied, so it can be blended over the scene exactly once
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+
+        SubmitDrawData(draw_data, scale);
+
+        EndBlendMode();
+        EndTextureMode();
+
+        UILayerHash = hash;
+        UILayerValid = true;
+    }
+    else
+    {
+        // nothing of the draw data is submitted this frame
+        RenderStats = rlImGuiRenderStats{ 0 };
+        UILayerReuses++;
+    }
+
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTexturePro(UILayer.texture,
+        Rectangle{ 0, 0, float(width), -float(height) },
+        Rectangle{ draw_data->DisplayPos.x, draw_data->DisplayPos.y, draw_data->DisplaySize.x, draw_data->DisplaySize.y },
+        Vector2{ 0, 0 }, 0, WHITE);
+    EndBlendMode();
+
+    RenderStats.renderTime = float((GetTime() - start) * 1000.0);
+}
+
+static void UnloadCachedLayer(void)
+{
+    if (UILayer.id != 0)
+        UnloadRenderTexture(UILayer);
+
+    UILayer = RenderTexture{ 0 };
+    UILayerValid = false;
+}
+
+static size_t ArenaAlign(size_t size)
+{
+    return (size + 15) & ~size_t(15);
+}
+
+// points the vector at the arena cursor and copies the source there
+template<typename T>
+static void CopyToArena(ImVector<T>& vector, const ImVector<T>& source, char*& cursor)
+{
+    vector.Data = reinterpret_cast<T*>(cursor);
+    vector.Size = vector.Capacity = source.Size;
+
+    if (source.Size > 0)
+        memcpy(cursor, source.Data, source.size_in_bytes());
+
+    cursor += ArenaAlign(source.size_in_bytes());
+}
+
+// detaches a vector from the arena, so ImDrawList's destructor does not free it
+template<typename T>
+static void DetachFromArena(ImVector<T>& vector)
+{
+    vector.Data = nullptr;
+    vector.Size = vector.Capacity = 0;
+}
+
+static void CaptureSnapshot(DrawDataSnapshot& snapshot, const ImDrawData* draw_data)
+{
+    size_t arenaSize = 0;
+    for (int l = 0; l < draw_data->CmdListsCount; l++)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists[l];
+        arenaSize += ArenaAlign(commandList->VtxBuffer.size_in_bytes());
+        arenaSize += ArenaAlign(commandList->IdxBuffer.size_in_bytes());
+        arenaSize += ArenaAlign(commandList->CmdBuffer.size_in_bytes());
+#if IMGUI_VERSION_NUM >= 19140
+        arenaSize += ArenaAlign(commandList->_CallbacksDataBuf.size_in_bytes());
+#endif
+    }
+
+    // sized before any list points into it, growing later would move the arena
+    if (size_t(snapshot.Arena.Size) < arenaSize)
+        snapshot.Arena.resize(int(arenaSize));
+
+    while (snapshot.Lists.Size < draw_data->CmdListsCount)
+        snapshot.Lists.push_back(IM_NEW(ImDrawList)(nullptr));
+
+    snapshot.Data.CmdLists.resize(draw_data->CmdListsCount);
+
+    char* cursor = snapshot.Arena.Data;
+    for (int l = 0; l < draw_data->CmdListsCount; l++)
+    {
+        const ImDrawList* source = draw_data->CmdLists[l];
+        ImDrawList* commandList = snapshot.Lists[l];
+
+        CopyToArena(commandList->VtxBuffer, source->VtxBuffer, cursor);
+        CopyToArena(commandList->IdxBuffer, source->IdxBuffer, cursor);
+        CopyToArena(commandList->CmdBuffer, source->CmdBuffer, cursor);
+        commandList->Flags = source->Flags;
+
+#if IMGUI_VERSION_NUM >= 19140
+        // callback data copied by ImDrawList::AddCallback lives in the source list, which ImGui reuses next frame
+        ImVector<char> callbackData;
+        CopyToArena(callbackData, source->_CallbacksDataBuf, cursor);
+        for (ImDrawCmd& cmd : commandList->CmdBuffer)
+        {
+            if (cmd.UserCallback != nullptr && cmd.UserCallbackDataSize > 0)
+                cmd.UserCallbackData = callbackData.Data + cmd.UserCallbackDataOffset;
+        }
+        DetachFromArena(callbackData);
+#endif
+
+        snapshot.Data.CmdLists[l] = commandList;
+    }
+
+    snapshot.Data.Valid = draw_data->Valid;
+    snapshot.Data.CmdListsCount = draw_data->CmdListsCount;
+    snapshot.Data.TotalIdxCount = draw_data->TotalIdxCount;
+    snapshot.Data.TotalVtxCount = draw_data->TotalVtxCount;
+    snapshot.Data.DisplayPos = draw_data->DisplayPos;
+    snapshot.Data.DisplaySize = draw_data->DisplaySize;
+    snapshot.Data.FramebufferScale = draw_data->FramebufferScale;
+    snapshot.Data.OwnerViewport = nullptr;
+
+#ifdef RLIMGUI_DYNAMIC_TEXTURES
+    // the UI thread keeps changing the texture data, see rlImGuiBeginDelta
+    snapshot.Data.Textures = nullptr;
+#endif
+}
+
+static void UnloadSnapshots(void)
+{
+    PublishedSnapshot = -1;
+
+    for (DrawDataSnapshot& snapshot : Snapshots)
+    {
+        std::lock_guard<std::mutex> lock(snapshot.Lock);
+
+        for (ImDrawList* commandList : snapshot.Lists)
+        {
+            DetachFromArena(commandList->VtxBuffer);
+            DetachFromArena(commandList->IdxBuffer);
+            DetachFromArena(commandList->CmdBuffer);
+            IM_DELETE(commandList);
+        }
+
+        snapshot.Lists.clear();
+        snapshot.Arena.clear();
+        snapshot.Data.Clear();
+    }
+}
+
+static void SetupMouseCursors(void)
+{
+    MouseCursorMap[ImGuiMouseCursor_Arrow] = MOUSE_CURSOR_ARROW;
+    MouseCursorMap[ImGuiMouseCursor_TextInput] = MOUSE_CURSOR_IBEAM;
+    MouseCursorMap[ImGuiMouseCursor_Hand] = MOUSE_CURSOR_POINTING_HAND;
+    MouseCursorMap[ImGuiMouseCursor_ResizeAll] = MOUSE_CURSOR_RESIZE_ALL;
+    MouseCursorMap[ImGuiMouseCursor_ResizeEW] = MOUSE_CURSOR_RESIZE_EW;
+    MouseCursorMap[ImGuiMouseCursor_ResizeNESW] = MOUSE_CURSOR_RESIZE_NESW;
+    MouseCursorMap[ImGuiMouseCursor_ResizeNS] = MOUSE_CURSOR_RESIZE_NS;
+    MouseCursorMap[ImGuiMouseCursor_ResizeNWSE] = MOUSE_CURSOR_RESIZE_NWSE;
+    MouseCursorMap[ImGuiMouseCursor_NotAllowed] = MOUSE_CURSOR_NOT_ALLOWED;
+}
+
+#if !defined(NO_FONT_AWESOME) && !defined(RLIMGUI_DYNAMIC_TEXTURES)
+#define RLIMGUI_LAZY_ICONS
+#endif
+
+#ifdef RLIMGUI_LAZY_ICONS
+// icons registered so far when Font Awesome is rasterized lazily, see rlImGuiSetLazyIcons
+static bool LazyIcons = false;
+static bool LazyIconsDirty = false;
+static ImFontGlyphRangesBuilder LazyIconSet;
+static ImVector<ImWchar> LazyIconRanges;       // the glyph ranges of the merged icon font config
+
+static void AddLazyIcons(const char* text)
+{
+    for (const unsigned char* c = (const unsigned char*)text; *c != 0; c++)
+    {
+        // every icon is in the private use area, so it is always a 3 byte UTF-8 sequence
+        if ((c[0] & 0xF0) != 0xE0 || (c[1] & 0xC0) != 0x80 || (c[2] & 0xC0) != 0x80)
+            continue;
+
+        ImWchar codepoint = ImWchar(((c[0] & 0x0F) << 12) | ((c[1] & 0x3F) << 6) | (c[2] & 0x3F));
+        if (codepoint >= ICON_MIN_FA && codepoint <= ICON_MAX_FA && !LazyIconSet.GetBit(codepoint))
+        {
+            LazyIconSet.AddChar(codepoint);
+            LazyIconsDirty = true;
+        }
+        c += 2;
+    }
+}
+
+// points the icon font config at the current icon set, the ranges buffer moves as it is rebuilt
+static void BuildLazyIconRanges(ImFontAtlas* atlas)
+{
+    const ImWchar* previous = LazyIconRanges.Data;
+
+    LazyIconRanges.clear();
+    LazyIconSet.BuildRanges(&LazyIconRanges);
+
+    if (atlas == nullptr || previous == nullptr)
+        return;
+
+    for (ImFontConfig& config : atlas->ConfigData)
+    {
+        if (config.GlyphRanges == previous)
+            config.GlyphRanges = LazyIconRanges.Data;
+    }
+}
+
+// rebuilds the atlas with the icons first used last frame, before the next frame locks it
+static void UpdateLazyIcons(void)
+{
+    // with snapshots the UI thread may not touch the GPU, icons must be registered before setup
+    if (!LazyIcons || !LazyIconsDirty || PublishedSnapshot.load() >= 0)
+        return;
+
+    LazyIconsDirty = false;
+
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    BuildLazyIconRanges(atlas);
+    atlas->ClearTexData();
+    ReloadFonts();
+}
+#endif
+
+void SetupFontAwesome(ImFontAtlas* atlas, float dpiScale, bool highDPI)
+{
+#ifndef NO_FONT_AWESOME
+    static const ImWchar icons_ranges[] = { ICON_MIN_FA, ICON_MAX_FA, 0 };
+    ImFontConfig icons_config;
+    icons_config.MergeMode = true;
+    icons_config.PixelSnapH = true;
+    icons_config.FontDataOwnedByAtlas = false;
+
+    icons_config.GlyphMaxAdvanceX = std::numeric_limits<float>::max();
+    icons_config.RasterizerMultiply = 1.0f;
+    icons_config.OversampleH = 2;
+    icons_config.OversampleV = 1;
+
+    icons_config.GlyphRanges = icons_ranges;
+
+    float size = FONT_AWESOME_ICON_SIZE;
+#if !defined(__APPLE__)
+    if (!highDPI)
+        size *= dpiScale;
+
+
+	icons_config.RasterizerMultiply = dpiScale;
+#else
+    (void)dpiScale;
+    (void)highDPI;
+#endif
+
+#ifdef RLIMGUI_SDF_FONTS
+    // merged into the default font, so baked at the same scale and scaled along with it
+    size = FONT_AWESOME_ICON_SIZE / SDFDefaultFontScale;
+    icons_config.RasterizerMultiply = 1.0f;
+    icons_config.OversampleH = 1;
+#endif
+
+#ifdef RLIMGUI_LAZY_ICONS
+    // only the registered icons are rasterized, the atlas is rebuilt as new ones are used
+    if (LazyIcons)
+    {
+        BuildLazyIconRanges(nullptr);
+        LazyIconsDirty = false;
+        icons_config.GlyphRanges = LazyIconRanges.Data;
+    }
+#endif
+
+    atlas->AddFontFromMemoryCompressedTTF((void*)fa_solid_900_compressed_data, fa_solid_900_compressed_size, size, &icons_config, icons_config.GlyphRanges);
+#else
+    (void)atlas;
+    (void)dpiScale;
+    (void)highDPI;
+#endif
+
+}
+
+void SetupBackend(void)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendPlatformName = "imgui_impl_raylib";
+    io.BackendFlags |= ImGuiBackendFlags_HasGamepad | ImGuiBackendFlags_HasSetMousePos;
+
+    // both renderers honor ImDrawCmd::VtxOffset, so ImGui does not need to split large lists at 64K vertices
+    io.BackendRendererName = "imgui_impl_raylib";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+#ifdef RLIMGUI_DYNAMIC_TEXTURES
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+    io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+#endif
+#endif
+
+#ifndef PLATFORM_DRM
+    io.BackendFlags |= ImGuiBackendFlags_HasMouseCursors;
+#endif
+
+    io.MousePos = ImVec2(0, 0);
+
+    ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
+
+    platformIO.Platform_SetClipboardTextFn = SetClipTextCallback;
+    platformIO.Platform_GetClipboardTextFn = GetClipTextCallback;
+
+    platformIO.Platform_ClipboardUserData = nullptr;
+}
+
+void rlImGuiEndInitImGui(void)
+{
+    ImGui::SetCurrentContext(GlobalContext);
+
+    SetupFontAwesome(ImGui::GetIO().Fonts, GetFontDPIScale(), GetFontHighDPI());
+
+    SetupMouseCursors();
+
+    SetupBackend();
+
+    ReloadFonts();
+}
+
+static void SetupKeymap(void)
+{
+    HeldKeys.clear();
+}
+
+static void AddDefaultFont(ImFontAtlas* atlas, float dpiScale, bool highDPI)
+{
+    ImFontConfig defaultConfig;
+
+	static constexpr int DefaultFonSize = 13;
+
+    defaultConfig.SizePixels = DefaultFonSize;
+#if !defined(__APPLE__)
+	if (!highDPI)
+        defaultConfig.SizePixels = ceilf(defaultConfig.SizePixels * dpiScale);
+
+    defaultConfig.RasterizerMultiply = dpiScale;
+#else
+    (void)dpiScale;
+    (void)highDPI;
+#endif
+
+#ifdef RLIMGUI_SDF_FONTS
+    // baked once at a large size, ImGuiNewFrame scales it to DefaultFonSize at the current DPI
+    defaultConfig.SizePixels = RLIMGUI_SDF_FONT_SIZE;
+    defaultConfig.RasterizerMultiply = 1.0f;
+    SDFDefaultFontScale = DefaultFonSize / float(RLIMGUI_SDF_FONT_SIZE);
+
+    // room for the distance field around every glyph, and geometry lines instead of baked line textures
+    atlas->TexGlyphPadding = 2 * RLIMGUI_SDF_SPREAD;
+    atlas->Flags |= ImFontAtlasFlags_NoBakedLines;
+#endif
+
+    defaultConfig.PixelSnapH = true;
+#ifdef RLIMGUI_SDF_FONTS
+    SDFDefaultFont = atlas->AddFontDefault(&defaultConfig);
+#else
+    atlas->AddFontDefault(&defaultConfig);
+#endif
+}
+
+static void SetupGlobals(void)
+{
+    LastFrameFocused = IsWindowFocused();
+    LastControlPressed = false;
+    LastShiftPressed = false;
+    LastAltPressed = false;
+    LastSuperPressed = false;
+}
+
+void rlImGuiBeginInitImGui(void)
+{
+    SetupGlobals();
+    if (GlobalContext == nullptr)
+        GlobalContext = ImGui::CreateContext(nullptr);
+    SetupKeymap();
+
+    AddDefaultFont(ImGui::GetIO().Fonts, GetFontDPIScale(), GetFontHighDPI());
+}
+
+void rlImGuiSetup(bool dark)
+{
+    rlImGuiBeginInitImGui();
+
+    if (dark)
+        ImGui::StyleColorsDark();
+    else
+        ImGui::StyleColorsLight();
+
+    rlImGuiEndInitImGui();
+}
+
+void rlImGuiBeginSetupAsync(bool dark)
+{
+    rlImGuiEndSetupAsync();
+
+    SetupGlobals();
+    if (GlobalContext == nullptr)
+        GlobalContext = ImGui::CreateContext(nullptr);
+    ImGui::SetCurrentContext(GlobalContext);
+    SetupKeymap();
+
+    if (dark)
+        ImGui::StyleColorsDark();
+    else
+        ImGui::StyleColorsLight();
+
+    // the worker only touches the atlas, the window and GL context may be created meanwhile,
+    // so everything it needs from the window is read here
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    FontBuildDPIScale = GetFontDPIScale();
+    FontBuildHighDPI = GetFontHighDPI();
+    FontBuildDone = false;
+    FontBuildThread = std::thread([atlas, dpiScale = FontBuildDPIScale, highDPI = FontBuildHighDPI]()
+    {
+        AddDefaultFont(atlas, dpiScale, highDPI);
+        SetupFontAwesome(atlas, dpiScale, highDPI);
+        BuildFonts(atlas, dpiScale, highDPI);
+        FontBuildDone = true;
+    });
+}
+
+bool rlImGuiIsSetupReady(void)
+{
+    return !FontBuildThread.joinable() || FontBuildDone.load();
+}
+
+void rlImGuiEndSetupAsync(void)
+{
+    if (!FontBuildThread.joinable())
+        return;
+
+    FontBuildThread.join();
+    ImGui::SetCurrentContext(GlobalContext);
+    SetupGlobals();
+
+#ifndef RLIMGUI_SDF_FONTS
+    // the build may have started before the window existed, bake again if the guessed DPI was wrong
+    float dpiScale = GetFontDPIScale();
+    bool highDPI = GetFontHighDPI();
+    if (dpiScale != FontBuildDPIScale || highDPI != FontBuildHighDPI)
+    {
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        atlas->Clear();
+        AddDefaultFont(atlas, dpiScale, highDPI);
+        SetupFontAwesome(atlas, dpiScale, highDPI);
+        BuildFonts(atlas, dpiScale, highDPI);
+    }
+#endif
+
+    SetupMouseCursors();
+
+    SetupBackend();
+
+    UploadFonts();
+}
+
+void rlImGuiReloadFonts(void)
+{
+    ImGui::SetCurrentContext(GlobalContext);
+
+    ReloadFonts();
+}
+
+void rlImGuiSetLazyIcons(bool enabled)
+{
+#ifdef RLIMGUI_LAZY_ICONS
+    LazyIcons = enabled;
+#else
+    (void)enabled;
+#endif
+}
+
+void rlImGuiAddIcons(const char* icons)
+{
+#ifdef RLIMGUI_LAZY_ICONS
+    if (icons != nullptr)
+        AddLazyIcons(icons);
+#else
+    (void)icons;
+#endif
+}
+
+const char* rlImGuiIcons(const char* text)
+{
+    rlImGuiAddIcons(text);
+    return text;
+}
+
+void rlImGuiSetFontCache(const char* fileName)
+{
+#ifndef RLIMGUI_DYNAMIC_TEXTURES
+    snprintf(FontCachePath, sizeof(FontCachePath), "%s", fileName ? fileName : "");
+#else
+    (void)fileName;
+#endif
+}
+
+bool rlImGuiStartRecording(const char* fileName)
+{
+    if (fileName == nullptr || fileName[0] == 0)
+        return false;
+
+    snprintf(RecordPath, sizeof(RecordPath), "%s", fileName);
+
+    RecordData.clear();
+    RecordData.resize(int(2 * sizeof(unsigned int)));
+    memcpy(RecordData.Data, &InputRecordMagic, sizeof(unsigned int));
+    memcpy(RecordData.Data + sizeof(unsigned int), &InputRecordVersion, sizeof(unsigned int));
+
+    // events start with the next frame, they must belong to a frame header
+    RecordFrameOffset = -1;
+    RecordFrameCount = 0;
+    LastRecordedMousePos.X = LastRecordedMousePos.Y = -FLT_MAX;
+    Recording = true;
+    return true;
+}
+
+bool rlImGuiStopRecording(void)
+{
+    if (!Recording)
+        return false;
+
+    Recording = false;
+    RecordFrameOffset = -1;
+
+    bool saved = SaveFileData(RecordPath, RecordData.Data, RecordData.Size);
+    if (!saved)
+        TraceLog(LOG_WARNING, "RLIMGUI: Could not write input recording %s", RecordPath);
+
+    RecordData.clear();
+    return saved;
+}
+
+bool rlImGuiStartReplay(const char* fileName)
+{
+    EndReplay();
+
+    int size = 0;
+    unsigned char* data = LoadFileData(fileName, &size);
+    if (data == nullptr)
+        return false;
+
+    // walk every frame header up front, so replaying never reads past the end
+    unsigned int header[2] = { 0 };
+    bool valid = size >= int(sizeof(header));
+    if (valid)
+    {
+        memcpy(header, data, sizeof(header));
+        valid = header[0] == InputRecordMagic && header[1] == InputRecordVersion;
+    }
+
+    size_t offset = sizeof(header);
+    unsigned int frames = 0;
+    while (valid && offset < size_t(size))
+    {
+        RecordedInputFrame frame;
+        if (size_t(size) - offset < sizeof(frame))
+        {
+            valid = false;
+            break;
+        }
+        memcpy(&frame, data + offset, sizeof(frame));
+        offset += sizeof(frame);
+
+        if (frame.EventCount > (size_t(size) - offset) / sizeof(RecordedInputEvent))
+        {
+            valid = false;
+            break;
+        }
+        offset += frame.EventCount * sizeof(RecordedInputEvent);
+        frames++;
+    }
+
+    if (!valid || frames == 0)
+    {
+        TraceLog(LOG_WARNING, "RLIMGUI: %s is not an input recording", fileName);
+        UnloadFileData(data);
+        return false;
+    }
+
+    ReplayData.resize(size);
+    memcpy(ReplayData.Data, data, size);
+    UnloadFileData(data);
+
+    ReplayOffset = int(sizeof(header));
+    Replaying = true;
+    InputResetPending = false;
+    if (GlobalContext != nullptr)
+        ImGui::SetCurrentContext(GlobalContext);
+    ResetInputState();
+
+    TraceLog(LOG_INFO, "RLIMGUI: Replaying %u frames from %s", frames, fileName);
+    return true;
+}
+
+void rlImGuiStopReplay(void)
+{
+    if (!Replaying)
+        return;
+
+    EndReplay();
+    if (GlobalContext != nullptr)
+        ImGui::SetCurrentContext(GlobalContext);
+    ResetInputState();
+}
+
+bool rlImGuiIsReplaying(void)
+{
+    return Replaying;
+}
+
+void rlImGuiMarkPresent(void)
+{
+    if (!PresentPending || StatsHistoryCount == 0)
+        return;
+
+    // the newest history entry is the frame that was just presented
+    rlImGuiRenderStats& frame = StatsHistory[(StatsHistoryNext + RLIMGUI_STATS_HISTORY - 1) % RLIMGUI_STATS_HISTORY];
+    frame.inputToPresent = MillisecondsBetween(PresentInputTime, GetTime());
+    PresentPending = false;
+}
+
+void rlImGuiSetLowLatency(bool enabled)
+{
+    LowLatencyMouse = enabled;
+}
+
+void rlImGuiSetMouseEventQueue(bool enabled)
+{
+#ifdef RLIMGUI_GLFW_INPUT
+    UseMouseEventQueue = enabled;
+    MouseEventQueue.clear();
+    ForwardedMouseMoves.clear();
+#else
+    (void)enabled;
+#endif
+}
+
+int rlImGuiGetMouseMoves(Vector2* positions, double* times, int maxCount)
+{
+#ifdef RLIMGUI_GLFW_INPUT
+    int count = std::min(ForwardedMouseMoves.Size, maxCount);
+    for (int i = 0; i < count; i++)
+    {
+        if (positions)
+            positions[i] = Vector2{ ForwardedMouseMoves[i].Event.X, ForwardedMouseMoves[i].Event.Y };
+        if (times)
+            times[i] = ForwardedMouseMoves[i].Time;
+    }
+    return count;
+#else
+    (void)positions;
+    (void)times;
+    (void)maxCount;
+    return 0;
+#endif
+}
+
+static rlImGuiLatency GetLatencyPercentiles(float* values, int count)
+{
+    rlImGuiLatency result = { 0 };
+    if (count == 0)
+        return result;
+
+    std::sort(values, values + count);
+    auto at = [values, count](float p) { return values[std::min(count - 1, int(p * float(count - 1) + 0.5f))]; };
+
+    result.p50 = at(0.50f);
+    result.p90 = at(0.90f);
+    result.p99 = at(0.99f);
+    result.max = values[count - 1];
+    return result;
+}
+
+rlImGuiLatencyStats rlImGuiGetLatencyStats(void)
+{
+    static float toSample[RLIMGUI_STATS_HISTORY];
+    static float toSubmit[RLIMGUI_STATS_HISTORY];
+    static float toPresent[RLIMGUI_STATS_HISTORY];
+    int count = 0, presented = 0;
+
+    for (int i = 0; i < StatsHistoryCount; i++)
+    {
+        const rlImGuiRenderStats& frame = StatsHistory[i];
+
+        // frames without input have no input latency, only GLFW builds can tell
+#ifdef RLIMGUI_GLFW_INPUT
+        if (frame.rawInputEvents == 0)
+            continue;
+#endif
+
+        toSample[count] = frame.inputToSample;
+        toSubmit[count] = frame.inputToSubmit;
+        count++;
+
+        if (frame.inputToPresent > 0)
+            toPresent[presented++] = frame.inputToPresent;
+    }
+
+    rlImGuiLatencyStats stats = { 0 };
+    stats.frames = count;
+    stats.presentedFrames = presented;
+    stats.inputToSample = GetLatencyPercentiles(toSample, count);
+    stats.inputToSubmit = GetLatencyPercentiles(toSubmit, count);
+    stats.inputToPresent = GetLatencyPercentiles(toPresent, presented);
+    return stats;
+}
+
+rlImGuiRenderStats rlImGuiGetRenderStats(void)
+{
+    if (StatsHistoryCount == 0)
+        return rlImGuiRenderStats{ 0 };
+
+    return StatsHistory[(StatsHistoryNext + RLIMGUI_STATS_HISTORY - 1) % RLIMGUI_STATS_HISTORY];
+}
+
+int rlImGuiGetRenderStatsHistory(rlImGuiRenderStats* stats, int maxCount)
+{
+    int count = std::min(maxCount, StatsHistoryCount);
+    if (stats == nullptr || count <= 0)
+        return 0;
+
+    // the newest count frames, oldest first
+    int first = (StatsHistoryNext + RLIMGUI_STATS_HISTORY - count) % RLIMGUI_STATS_HISTORY;
+    for (int i = 0; i < count; i++)
+        stats[i] = StatsHistory[(first + i) % RLIMGUI_STATS_HISTORY];
+
+    return count;
+}
+
+bool rlImGuiExportRenderStats(const char* fileName)
+{
+    static rlImGuiRenderStats history[RLIMGUI_STATS_HISTORY];
+    int count = rlImGuiGetRenderStatsHistory(history, RLIMGUI_STATS_HISTORY);
+
+    ImGuiTextBuffer csv;
+    csv.append("drawLists,drawCommands,mergedCommands,vertices,indices,batchFlushes,flushesSaved,culledCommands,"
+        "scissorChanges,scissorsSkipped,textureSwitches,texturesSkipped,renderTime,processEventsTime,"
+        "idleFramesSkipped,totalFramesSkipped,cachedLayerReuses,rawInputEvents,inputToSample,inputToProcess,inputToSubmit,inputToPresent\n");
+
+    for (int i = 0; i < count; i++)
+    {
+        const rlImGuiRenderStats& frame = history[i];
+        csv.appendf("%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.4f,%.4f,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f\n",
+            frame.drawLists, frame.drawCommands, frame.mergedCommands, frame.vertices, frame.indices,
+            frame.batchFlushes, frame.flushesSaved, frame.culledCommands, frame.scissorChanges, frame.scissorsSkipped,
+            frame.textureSwitches, frame.texturesSkipped, frame.renderTime, frame.processEventsTime,
+            frame.idleFramesSkipped, frame.totalFramesSkipped, frame.cachedLayerReuses, frame.rawInputEvents,
+            frame.inputToSample, frame.inputToProcess, frame.inputToSubmit, frame.inputToPresent);
+    }
+
+    return SaveFileText(fileName, csv.Buf.Data);
+}
+
+void rlImGuiShowRenderStats(bool* open)
+{
+    if (!ImGui::Begin("rlImGui Render Stats", open))
+    {
+        ImGui::End();
+        return;
+    }
+
+    static rlImGuiRenderStats history[RLIMGUI_STATS_HISTORY];
+    int count = rlImGuiGetRenderStatsHistory(history, RLIMGUI_STATS_HISTORY);
+
+    static float renderTimes[RLIMGUI_STATS_HISTORY];
+    static float eventTimes[RLIMGUI_STATS_HISTORY];
+    static float flushes[RLIMGUI_STATS_HISTORY];
+    float maxRenderTime = 0, averageRenderTime = 0;
+    for (int i = 0; i < count; i++)
+    {
+        renderTimes[i] = history[i].renderTime;
+        eventTimes[i] = history[i].processEventsTime;
+        flushes[i] = float(history[i].batchFlushes);
+        maxRenderTime = std::max(maxRenderTime, renderTimes[i]);
+        averageRenderTime += renderTimes[i] / count;
+    }
+
+    rlImGuiRenderStats last = rlImGuiGetRenderStats();
+
+    ImGui::Text("Draw lists %d, commands %d (%d merged, %d culled)", last.drawLists, last.drawCommands, last.mergedCommands, last.culledCommands);
+    ImGui::Text("Vertices %d, indices %d", last.vertices, last.indices);
+    ImGui::Text("Batch flushes %d (%d saved)", last.batchFlushes, last.flushesSaved);
+    ImGui::Text("Texture switches %d (%d skipped)", last.textureSwitches, last.texturesSkipped);
+    ImGui::Text("Scissor changes %d (%d skipped)", last.scissorChanges, last.scissorsSkipped);
+    ImGui::Text("Frames skipped %d, cached layer reuses %d", last.totalFramesSkipped, last.cachedLayerReuses);
+
+    ImGui::Separator();
+
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "%.3f ms avg %.3f ms max", averageRenderTime, maxRenderTime);
+    ImGui::PlotLines("RenderDrawData", renderTimes, count, 0, overlay, 0, FLT_MAX, ImVec2(0, 60));
+
+    snprintf(overlay, sizeof(overlay), "%.3f ms", last.processEventsTime);
+    ImGui::PlotLines("ProcessEvents", eventTimes, count, 0, overlay, 0, FLT_MAX, ImVec2(0, 60));
+
+    snprintf(overlay, sizeof(overlay), "%d", last.batchFlushes);
+    ImGui::PlotHistogram("Batch flushes", flushes, count, 0, overlay, 0, FLT_MAX, ImVec2(0, 60));
+
+    ImGui::Separator();
+
+    rlImGuiLatencyStats latency = rlImGuiGetLatencyStats();
+    ImGui::Text("Input latency over %d frames with input, p50 / p90 / p99 ms", latency.frames);
+    ImGui::Text("To sample  %6.2f %6.2f %6.2f", latency.inputToSample.p50, latency.inputToSample.p90, latency.inputToSample.p99);
+    ImGui::Text("To submit  %6.2f %6.2f %6.2f", latency.inputToSubmit.p50, latency.inputToSubmit.p90, latency.inputToSubmit.p99);
+    if (latency.presentedFrames > 0)
+        ImGui::Text("To present %6.2f %6.2f %6.2f", latency.inputToPresent.p50, latency.inputToPresent.p90, latency.inputToPresent.p99);
+    else
+        ImGui::TextDisabled("To present: call rlImGuiMarkPresent after EndDrawing");
+
+    ImGui::Checkbox("Low latency mouse", &LowLatencyMouse);
+
+    ImGui::Separator();
+
+    rlImGuiRenderTargetStats targets = rlImGuiGetRenderTargetStats();
+    ImGui::Text("Render targets %d (%d in use), %.1f MB", targets.targets, targets.inUse, targets.bytesHeld / (1024.0 * 1024.0));
+    ImGui::Text("Acquired %d, reused %d, allocated %d", targets.acquires, targets.reuses, targets.allocations);
+
+    if (ImGui::Button("Export CSV"))
+        rlImGuiExportRenderStats("rlImGuiRenderStats.csv");
+
+    ImGui::End();
+}
+
+// mixes a 64 bit word at a time, only used to tell if a frame changed so it does not need to be cryptographic
+static uint64_t HashBytes(const void* data, size_t size, uint64_t hash)
+{
+    constexpr uint64_t prime = 0x100000001b3ull;
+
+    const unsigned char* bytes = (const unsigned char*)data;
+    while (size >= sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 29;
+
+        bytes += sizeof(word);
+        size -= sizeof(word);
+    }
+
+    while (size > 0)
+    {
+        hash = (hash ^ *bytes++) * prime;
+        size--;
+    }
+
+    return hash;
+}
+
+static uint64_t HashDrawData(const ImDrawData* draw_data)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    hash = HashBytes(&draw_data->DisplayPos, sizeof(ImVec2), hash);
+    hash = HashBytes(&draw_data->DisplaySize, sizeof(ImVec2), hash);
+    hash = HashBytes(&draw_data->FramebufferScale, sizeof(ImVec2), hash);
+    hash = HashBytes(&draw_data->CmdListsCount, sizeof(int), hash);
+
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists[l];
+
+        hash = HashBytes(commandList->VtxBuffer.Data, commandList->VtxBuffer.size_in_bytes(), hash);
+        hash = HashBytes(commandList->IdxBuffer.Data, commandList->IdxBuffer.size_in_bytes(), hash);
+
+        // field by field, ImDrawCmd has padding
+        for (const auto& cmd : commandList->CmdBuffer)
+        {
+            hash = HashBytes(&cmd.ClipRect, sizeof(cmd.ClipRect), hash);
+#ifdef RLIMGUI_DYNAMIC_TEXTURES
+            // the reference, not the resolved id, the texture may not be created until the frame is submitted
+            hash = HashBytes(&cmd.TexRef, sizeof(cmd.TexRef), hash);
+#else
+            hash = HashBytes(&cmd.TextureId, sizeof(cmd.TextureId), hash);
+#endif
+            hash = HashBytes(&cmd.VtxOffset, sizeof(cmd.VtxOffset), hash);
+            hash = HashBytes(&cmd.IdxOffset, sizeof(cmd.IdxOffset), hash);
+            hash = HashBytes(&cmd.ElemCount, sizeof(cmd.ElemCount), hash);
+            hash = HashBytes(&cmd.UserCallback, sizeof(cmd.UserCallback), hash);
+            hash = HashBytes(&cmd.UserCallbackData, sizeof(cmd.UserCallbackData), hash);
+        }
+    }
+
+#ifdef RLIMGUI_DYNAMIC_TEXTURES
+    // pending texture requests are only applied when a frame is submitted, so they always count as a change
+    static uint64_t textureRequests = 0;
+    if (draw_data->Textures != nullptr)
+    {
+        for (const ImTextureData* tex : *draw_data->Textures)
+        {
+            if (tex->Status != ImTextureStatus_OK)
+            {
+                textureRequests++;
+                hash = HashBytes(&textureRequests, sizeof(textureRequests), hash);
+            }
+        }
+    }
+#endif
+
+    return hash;
+}
+
+bool rlImGuiPrepareFrame(void)
+{
+    ImGui::SetCurrentContext(GlobalContext);
+    ImGui::Render();
+
+    FramePrepared = true;
+    PreparedFrameHash = HashDrawData(ImGui::GetDrawData());
+
+    bool invalidated = FrameInvalidated;
+    FrameInvalidated = false;
+    return invalidated || PreparedFrameHash != PresentedFrameHash;
+}
+
+void rlImGuiInvalidateFrame(void)
+{
+    FrameInvalidated = true;
+    UILayerValid = false;
+}
+
+void rlImGuiSkipFrame(void)
+{
+    FramePrepared = false;
+    IdleFramesSkipped++;
+    TotalFramesSkipped++;
+
+    // raylib's frame time only covers frames that went through EndDrawing from now on
+    MeasureFrameTime = true;
+
+    // the last presented frame stays on screen, just pace like EndDrawing would and keep input flowing.
+    // The time is counted from the start of this frame, the length of the last presented one (a hitch, or the
+    // first frame) would hold every idle frame that long
+    double wait = 1.0 / RLIMGUI_IDLE_FPS - (GetTime() - FrameStartTime);
+    if (wait > 0)
+        WaitTime(wait);
+    PollInputEvents();
+}
+
+void rlImGuiSetCachedLayer(bool enabled)
+{
+    UseCachedLayer = enabled;
+
+    if (!enabled)
+        UnloadCachedLayer();
+}
+
+void rlImGuiSetShader(Shader shader)
+{
+    BaseShader = shader;
+}
+
+void rlImGuiInvalidateCachedLayer(void)
+{
+    UILayerValid = false;
+}
+
+static void UploadDecodedImages(void);
+
+void rlImGuiBegin(void)
+{
+    ImGui::SetCurrentContext(GlobalContext);
+
+    double now = GetTime();
+    float deltaTime = MeasureFrameTime ? float(now - LastBeginTime) : GetFrameTime();
+    LastBeginTime = now;
+
+    rlImGuiBeginDelta(deltaTime);
+}
+
+void rlImGuiBeginDelta(float deltaTime)
+{
+    FrameStartTime = GetTime();
+
+    // finishes a setup started with rlImGuiBeginSetupAsync, waiting for the fonts if needed
+    rlImGuiEndSetupAsync();
+
+    ImGui::SetCurrentContext(GlobalContext);
+
+    // images decoded by the workers are uploaded here, on the GL thread, within the upload budget
+    UploadDecodedImages();
+
+#ifdef RLIMGUI_DYNAMIC_TEXTURES
+    // snapshots do not carry texture requests, apply them here while the UI thread is between frames
+    if (PublishedSnapshot.load() >= 0)
+        UpdateTextures(&ImGui::GetPlatformIO().Textures);
+#endif
+
+#ifdef RLIMGUI_LAZY_ICONS
+    UpdateLazyIcons();
+#endif
+
+    ImGuiNewFrame(deltaTime);
+    ImGui_ImplRaylib_ProcessEvents();
+    ImGui::NewFrame();
+
+    // the queued input events are applied to ImGui's state in NewFrame
+    FrameProcessTime = GetTime();
+}
+
+void rlImGuiEnd(void)
+{
+    ImGui::SetCurrentContext(GlobalContext);
+
+    // rlImGuiPrepareFrame may already have rendered this frame
+    if (FramePrepared)
+    {
+        PresentedFrameHash = PreparedFrameHash;
+    }
+    else
+    {
+        ImGui::Render();
+        PresentedFrameHash = UseCachedLayer ? HashDrawData(ImGui::GetDrawData()) : 0;
+    }
+    FramePrepared = false;
+
+    if (UseCachedLayer)
+        RenderCachedLayer(ImGui::GetDrawData(), PresentedFrameHash);
+    else
+        SubmitDrawData(ImGui::GetDrawData(), GetFramebufferScale(ImGui::GetDrawData()));
+
+    RenderStats.idleFramesSkipped = IdleFramesSkipped;
+    IdleFramesSkipped = 0;
+    RecordRenderStats();
+}
+
+void rlImGuiEndSnapshot(void)
+{
+    ImGui::SetCurrentContext(GlobalContext);
+
+    if (FramePrepared)
+        PresentedFrameHash = PreparedFrameHash;
+    else
+        ImGui::Render();
+    FramePrepared = false;
+
+    // the GL thread may still be drawing the published slot, write the other one
+    int slot = PublishedSnapshot.load() == 0 ? 1 : 0;
+    {
+        std::lock_guard<std::mutex> lock(Snapshots[slot].Lock);
+        CaptureSnapshot(Snapshots[slot], ImGui::GetDrawData());
+    }
+    PublishedSnapshot.store(slot);
+}
+
+bool rlImGuiDrawSnapshot(void)
+{
+    int slot = PublishedSnapshot.load();
+    if (slot < 0)
+        return false;
+
+    // blocks the UI thread from overwriting this slot until it is submitted
+    std::lock_guard<std::mutex> lock(Snapshots[slot].Lock);
+    ImGui_ImplRaylib_RenderDrawData(&Snapshots[slot].Data);
+    return true;
+}
+
+void rlImGuiShutdown(void)
+{
+    if (FontBuildThread.joinable())
+        FontBuildThread.join();
+
+    // a session still being recorded is kept
+    rlImGuiStopRecording();
+    EndReplay();
+
+#ifdef RLIMGUI_GLFW_INPUT
+    UninstallInputCallbacks();
+#endif
+
+    if (GlobalContext == nullptr)
+        return;
+
+    ImGui::SetCurrentContext(GlobalContext);
+    ImGui_ImplRaylib_Shutdown();
+
+    ImGui::DestroyContext(GlobalContext);
+    GlobalContext = nullptr;
+}
+
+void rlImGuiImage(const Texture* image)
+{
+    if (!image)
+        return;
+    
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+    
+    ImGui::Image((ImTextureID)image, ImVec2(float(image->width), float(image->height)));
+}
+
+bool rlImGuiImageButton(const char* name, const Texture* image)
+{
+    if (!image)
+        return false;
+    
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+    
+    return ImGui::ImageButton(name, (ImTextureID)image, ImVec2(float(image->width), float(image->height)));
+}
+
+bool rlImGuiImageButtonSize(const char* name, const Texture* image, Vector2 size)
+{
+    if (!image)
+        return false;
+    
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+   
+    return ImGui::ImageButton(name, (ImTextureID)image, ImVec2(size.x, size.y));
+}
+
+void rlImGuiImageSize(const Texture* image, int width, int height)
+{
+    if (!image)
+        return;
+    
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+    
+    ImGui::Image((ImTextureID)image, ImVec2(float(width), float(height)));
+}
+
+void rlImGuiImageSizeV(const Texture* image, Vector2 size)
+{
+    if (!image)
+        return;
+    
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+    
+    ImGui::Image((ImTextureID)image, ImVec2(size.x, size.y));
+}
+
+void rlImGuiImageRect(const Texture* image, int destWidth, int destHeight, Rectangle sourceRect)
+{
+    if (!image)
+        return;
+    
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+    
+    ImVec2 uv0;
+    ImVec2 uv1;
+
+    if (sourceRect.width < 0)
+    {
+        uv0.x = -((float)sourceRect.x / image->width);
+        uv1.x = (uv0.x - (float)(fabs(sourceRect.width) / image->width));
+    }
+    else
+    {
+        uv0.x = (float)sourceRect.x / image->width;
+        uv1.x = uv0.x + (float)(sourceRect.width / image->width);
+    }
+
+    if (sourceRect.height < 0)
+    {
+        uv0.y = -((float)sourceRect.y / image->height);
+        uv1.y = (uv0.y - (float)(fabs(sourceRect.height) / image->height));
+    }
+    else
+    {
+        uv0.y = (float)sourceRect.y / image->height;
+        uv1.y = uv0.y + (float)(sourceRect.height / image->height);
+    }
+
+    ImGui::Image((ImTextureID)image, ImVec2(float(destWidth), float(destHeight)), uv0, uv1);
+}
+
+void rlImGuiImageRenderTexture(const RenderTexture* image)
+{
+    if (!image)
+        return;
+    
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+    
+    rlImGuiImageRect(&image->texture, image->texture.width, image->texture.height, Rectangle{ 0,0, float(image->texture.width), -float(image->texture.height) });
+}
+
+void rlImGuiImageRenderTextureFit(const RenderTexture* image, bool center)
+{
+    if (!image)
+        return;
+    
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+
+    ImVec2 area = ImGui::GetContentRegionAvail();
+
+    float scale =  area.x / image->texture.width;
+
+    float y = image->texture.height * scale;
+    if (y > area.y)
+    {
+        scale = area.y / image->texture.height;
+    }
+
+    int sizeX = int(image->texture.width * scale);
+    int sizeY = int(image->texture.height * scale);
+
+    if (center)
+    {
+        ImGui::SetCursorPosX(0);
+        ImGui::SetCursorPosX(area.x/2 - sizeX/2);
+        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + (area.y / 2 - sizeY / 2));
+    }
+
+    rlImGuiImageRect(&image->texture, sizeX, sizeY, Rectangle{ 0,0, float(image->texture.width), -float(image->texture.height) });
+}
+
+// a render target of the pool, allocated on its own so the RenderTexture handed out keeps its address
+struct PooledRenderTarget
+{
+    RenderTexture Target;
+    bool InUse;
+    double ReleaseTime;
+};
+
+static ImVector<PooledRenderTarget*> RenderTargetPool;
+static rlImGuiRenderTargetStats RenderTargetStats = { 0 };
+static int RenderTargetWidth = 0;     // drawn corner of the target begun last
+static int RenderTargetHeight = 0;
+
+// color and depth, both 32 bits per pixel
+static long long GetRenderTargetBytes(const RenderTexture& target)
+{
+    return (long long)target.texture.width * target.texture.height * 8;
+}
+
+static int GetRenderTargetBucket(int size)
+{
+    return std::max(1, (size + RLIMGUI_RENDER_TARGET_BUCKET - 1) / RLIMGUI_RENDER_TARGET_BUCKET) * RLIMGUI_RENDER_TARGET_BUCKET;
+}
+
+static void UnloadPooledRenderTarget(int index)
+{
+    PooledRenderTarget* pooled = RenderTargetPool[index];
+    RenderTargetStats.bytesHeld -= GetRenderTargetBytes(pooled->Target);
+    RenderTargetStats.targets--;
+
+    UnloadRenderTexture(pooled->Target);
+    MemFree(pooled);
+    RenderTargetPool.erase(RenderTargetPool.begin() + index);
+}
+
+static void TrimRenderTargetPool(void)
+{
+    double now = GetTime();
+    for (int i = RenderTargetPool.Size - 1; i >= 0; i--)
+    {
+        if (!RenderTargetPool[i]->InUse && now - RenderTargetPool[i]->ReleaseTime > RLIMGUI_RENDER_TARGET_KEEP_SECONDS)
+            UnloadPooledRenderTarget(i);
+    }
+}
+
+static void UnloadRenderTargetPool(void)
+{
+    while (!RenderTargetPool.empty())
+        UnloadPooledRenderTarget(RenderTargetPool.Size - 1);
+
+    RenderTargetStats.inUse = 0;
+}
+
+RenderTexture* rlImGuiAcquireRenderTarget(int width, int height)
+{
+    TrimRenderTargetPool();
+    RenderTargetStats.acquires++;
+
+    int bucketWidth = GetRenderTargetBucket(width);
+    int bucketHeight = GetRenderTargetBucket(height);
+
+    for (PooledRenderTarget* pooled : RenderTargetPool)
+    {
+        if (!pooled->InUse && pooled->Target.texture.width == bucketWidth && pooled->Target.texture.height == bucketHeight)
+        {
+            pooled->InUse = true;
+            RenderTargetStats.inUse++;
+            RenderTargetStats.reuses++;
+            return &pooled->Target;
+        }
+    }
+
+    RenderTexture target = LoadRenderTexture(bucketWidth, bucketHeight);
+    if (target.id == 0)
+        return nullptr;
+
+    PooledRenderTarget* pooled = (PooledRenderTarget*)MemAlloc(sizeof(PooledRenderTarget));
+    pooled->Target = target;
+    pooled->InUse = true;
+    pooled->ReleaseTime = 0;
+    RenderTargetPool.push_back(pooled);
+
+    RenderTargetStats.targets++;
+    RenderTargetStats.inUse++;
+    RenderTargetStats.allocations++;
+    RenderTargetStats.bytesHeld += GetRenderTargetBytes(target);
+    return &pooled->Target;
+}
+
+void rlImGuiReleaseRenderTarget(RenderTexture* target)
+{
+    if (!target)
+        return;
+
+    for (PooledRenderTarget* pooled : RenderTargetPool)
+    {
+        if (&pooled->Target == target && pooled->InUse)
+        {
+            pooled->InUse = false;
+            pooled->ReleaseTime = GetTime();
+            RenderTargetStats.inUse--;
+            break;
+        }
+    }
+
+    TrimRenderTargetPool();
+}
+
+RenderTexture* rlImGuiResizeRenderTarget(RenderTexture* target, int width, int height)
+{
+    // within the same bucket nothing changes, most steps of a live resize end here
+    if (target && target->texture.width == GetRenderTargetBucket(width) && target->texture.height == GetRenderTargetBucket(height))
+        return target;
+
+    rlImGuiReleaseRenderTarget(target);
+    return rlImGuiAcquireRenderTarget(width, height);
+}
+
+void rlImGuiBeginRenderTarget(const RenderTexture* target, int width, int height)
+{
+    if (!target)
+        return;
+
+    BeginTextureMode(*target);
+
+    // only the width x height corner is drawn, 2D drawing uses it through the projection set here
+    width = std::min(width, target->texture.width);
+    height = std::min(height, target->texture.height);
+    rlViewport(0, 0, width, height);
+
+    rlMatrixMode(RL_PROJECTION);
+    rlLoadIdentity();
+    rlOrtho(0, width, height, 0, 0.0f, 1.0f);
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+
+    RenderTargetWidth = width;
+    RenderTargetHeight = height;
+}
+
+// same as BeginMode3D, which takes its aspect ratio from the whole render texture instead of the drawn corner
+void rlImGuiBeginRenderTargetMode3D(Camera3D camera)
+{
+    rlDrawRenderBatchActive();
+
+    rlMatrixMode(RL_PROJECTION);
+    rlPushMatrix();
+    rlLoadIdentity();
+
+    double aspect = double(std::max(1, RenderTargetWidth)) / double(std::max(1, RenderTargetHeight));
+    double top = (camera.projection == CAMERA_PERSPECTIVE) ? rlGetCullDistanceNear() * tan(camera.fovy * 0.5 * DEG2RAD) : camera.fovy / 2.0;
+    double right = top * aspect;
+
+    if (camera.projection == CAMERA_PERSPECTIVE)
+        rlFrustum(-right, right, -top, top, rlGetCullDistanceNear(), rlGetCullDistanceFar());
+    else
+        rlOrtho(-right, right, -top, top, rlGetCullDistanceNear(), rlGetCullDistanceFar());
+
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    rlMultMatrixf(MatrixToFloat(view));
+
+    rlEnableDepthTest();
+}
+
+// same as BeginScissorMode, which flips y with the height of the whole render texture instead of the drawn corner
+void rlImGuiBeginRenderTargetScissor(int x, int y, int width, int height)
+{
+    rlDrawRenderBatchActive();
+    rlEnableScissorTest();
+    rlScissor(x, RenderTargetHeight - (y + height), width, height);
+}
+
+void rlImGuiImageRenderTarget(const RenderTexture* target, int width, int height)
+{
+    if (!target)
+        return;
+
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+
+    // the drawn corner is at the bottom of the texture, render textures are stored upside down
+    const Texture& texture = target->texture;
+    ImVec2 uv0(0, float(height) / texture.height);
+    ImVec2 uv1(float(width) / texture.width, 0);
+    ImGui::Image((ImTextureID)&texture, ImVec2(float(width), float(height)), uv0, uv1);
+}
+
+rlImGuiRenderTargetStats rlImGuiGetRenderTargetStats(void)
+{
+    return RenderTargetStats;
+}
+
+// a tiled image only holds where its tiles are, the tiles live in the shared TileCache
+struct rlImGuiTiledImage
+{
+    char TilePath[512];
+    int Width;
+    int Height;
+    int TileSize;
+    int Levels;
+
+    // view of rlImGuiTiledImageViewer, a scale of 0 fits the image on the next frame
+    Vector2 ViewCenter;
+    float ViewScale;
+};
+
+// tiles are decoded by the image workers and uploaded within the image upload budget, see rlImGuiImageAsync
+struct AsyncImage;
+static AsyncImage* GetAsyncImage(const char* fileName, bool thumbnail);
+static const Texture2D* UseAsyncImage(AsyncImage* image);
+static void ReleaseAsyncImage(AsyncImage* image);
+static void HoldAsyncImage(AsyncImage* image, bool held);
+
+struct CachedTile
+{
+    const rlImGuiTiledImage* Image;
+    int Level;
+    int X;
+    int Y;
+    AsyncImage* Pixels;             // fails to load when the tile file does not exist
+    int LastUsedFrame;
+};
+
+static ImVector<CachedTile> TileCache;
+static ImGuiStorage TileCacheIndex;     // tile key -> index in TileCache + 1
+static int TileLoadFrame = -1;
+static int TileLoadsThisFrame = 0;
+
+static ImGuiID GetTileKey(const rlImGuiTiledImage* image, int level, int x, int y)
+{
+    int coords[3] = { level, x, y };
+    uint64_t hash = HashBytes(coords, sizeof(coords), uint64_t(uintptr_t(image)));
+    return ImGuiID(hash ^ (hash >> 32));
+}
+
+// the texture is only unloaded once the frames that drew it are rendered
+static void EvictTile(CachedTile& tile)
+{
+    if (tile.Image == nullptr)
+        return;
+
+    if (tile.Pixels != nullptr)
+    {
+        HoldAsyncImage(tile.Pixels, false);
+        ReleaseAsyncImage(tile.Pixels);
+    }
+
+    // a tile whose key collides may have taken over the index entry since
+    ImGuiID key = GetTileKey(tile.Image, tile.Level, tile.X, tile.Y);
+    if (TileCacheIndex.GetInt(key, 0) == int(&tile - TileCache.Data) + 1)
+        TileCacheIndex.SetInt(key, 0);
+    tile.Image = nullptr;
+    tile.Pixels = nullptr;
+}
+
+// the texture of a cached tile, requested if the frame's request budget allows, nullptr while it is not available
+static const Texture2D* GetTile(const rlImGuiTiledImage* image, int level, int x, int y)
+{
+    int frame = ImGui::GetFrameCount();
+    if (TileLoadFrame != frame)
+    {
+        TileLoadFrame = frame;
+        TileLoadsThisFrame = 0;
+    }
+
+    ImGuiID key = GetTileKey(image, level, x, y);
+    int index = TileCacheIndex.GetInt(key, 0) - 1;
+    if (index >= 0)
+    {
+        CachedTile& tile = TileCache[index];
+        if (tile.Image == image && tile.Level == level && tile.X == x && tile.Y == y)
+        {
+            tile.LastUsedFrame = frame;
+            return UseAsyncImage(tile.Pixels);
+        }
+    }
+
+    if (TileLoadsThisFrame >= RLIMGUI_TILE_LOADS_PER_FRAME)
+        return nullptr;
+
+    if (TileCache.Capacity < RLIMGUI_TILE_CACHE_SIZE)
+        TileCache.reserve(RLIMGUI_TILE_CACHE_SIZE);
+
+    // least recently used tile, but never one the last frame drew, its draw data may still be in flight
+    if (TileCache.Size < RLIMGUI_TILE_CACHE_SIZE)
+    {
+        TileCache.push_back(CachedTile{ nullptr, 0, 0, 0, nullptr, 0 });
+        index = TileCache.Size - 1;
+    }
+    else
+    {
+        index = -1;
+        for (int i = 0; i < TileCache.Size; i++)
+        {
+            if (TileCache[i].LastUsedFrame < frame - 1 && (index < 0 || TileCache[i].LastUsedFrame < TileCache[index].LastUsedFrame))
+                index = i;
+        }
+        if (index < 0)
+            return nullptr;
+
+        EvictTile(TileCache[index]);
+    }
+
+    char path[sizeof(image->TilePath) + 32];
+    snprintf(path, sizeof(path), image->TilePath, level, x, y);
+
+    CachedTile& tile = TileCache[index];
+    tile = CachedTile{ image, level, x, y, GetAsyncImage(path, false), frame };
+    HoldAsyncImage(tile.Pixels, true);
+    TileCacheIndex.SetInt(key, index + 1);
+    TileLoadsThisFrame++;
+
+    return UseAsyncImage(tile.Pixels);
+}
+
+// draws the source rect of the image, in full resolution pixels, into a screen rect with the tiles of the level
+// closest to the screen resolution. Tiles not loaded yet are covered with the part of a coarser level that is
+static void DrawTiledImage(ImDrawList* drawList, const rlImGuiTiledImage* image, ImVec2 screenMin, ImVec2 screenMax, Rectangle source)
+{
+    if (source.width <= 0 || source.height <= 0)
+        return;
+
+    float scale = (screenMax.x - screenMin.x) / source.width;
+    int level = (scale >= 1) ? 0 : std::min(image->Levels - 1, int(floorf(log2f(1.0f / scale))));
+
+    float levelTile = float(image->TileSize << level);
+    int firstX = std::max(0, int(floorf(source.x / levelTile)));
+    int firstY = std::max(0, int(floorf(source.y / levelTile)));
+    int lastX = std::min(int(ceilf(float(image->Width) / levelTile)), int(ceilf((source.x + source.width) / levelTile)));
+    int lastY = std::min(int(ceilf(float(image->Height) / levelTile)), int(ceilf((source.y + source.height) / levelTile)));
+
+    drawList->PushClipRect(screenMin, screenMax, true);
+    for (int y = firstY; y < lastY; y++)
+    {
+        for (int x = firstX; x < lastX; x++)
+        {
+            // the area of this tile in full resolution pixels
+            float minX = x * levelTile;
+            float minY = y * levelTile;
+            float maxX = std::min(minX + levelTile, float(image->Width));
+            float maxY = std::min(minY + levelTile, float(image->Height));
+
+            for (int coarse = level; coarse < image->Levels; coarse++)
+            {
+                float coarseTile = float(image->TileSize << coarse);
+                int tileX = int(minX / coarseTile);
+                int tileY = int(minY / coarseTile);
+
+                const Texture2D* tile = GetTile(image, coarse, tileX, tileY);
+                if (tile == nullptr)
+                    continue;
+
+                float originX = tileX * coarseTile;
+                float originY = tileY * coarseTile;
+                float extentX = float(tile->width << coarse);
+                float extentY = float(tile->height << coarse);
+
+                ImVec2 uv0((minX - originX) / extentX, (minY - originY) / extentY);
+                ImVec2 uv1((maxX - originX) / extentX, (maxY - originY) / extentY);
+                ImVec2 p0(screenMin.x + (minX - source.x) * scale, screenMin.y + (minY - source.y) * scale);
+                ImVec2 p1(screenMin.x + (maxX - source.x) * scale, screenMin.y + (maxY - source.y) * scale);
+
+                drawList->AddImage((ImTextureID)tile, p0, p1, uv0, uv1);
+                break;
+            }
+        }
+    }
+    drawList->PopClipRect();
+}
+
+rlImGuiTiledImage* rlImGuiLoadTiledImage(const char* tilePath, int width, int height, int tileSize, int levels)
+{
+    if (tilePath == nullptr || width <= 0 || height <= 0 || tileSize <= 0)
+        return nullptr;
+
+    // by default down to the level that fits in a single tile
+    if (levels <= 0)
+    {
+        levels = 1;
+        while (((width - 1) >> (levels - 1)) + 1 > tileSize || ((height - 1) >> (levels - 1)) + 1 > tileSize)
+            levels++;
+    }
+
+    rlImGuiTiledImage* image = (rlImGuiTiledImage*)MemAlloc(sizeof(rlImGuiTiledImage));
+    snprintf(image->TilePath, sizeof(image->TilePath), "%s", tilePath);
+    image->Width = width;
+    image->Height = height;
+    image->TileSize = tileSize;
+    image->Levels = levels;
+    image->ViewCenter = Vector2{ width * 0.5f, height * 0.5f };
+    image->ViewScale = 0;
+
+    return image;
+}
+
+void rlImGuiUnloadTiledImage(rlImGuiTiledImage* image)
+{
+    if (image == nullptr)
+        return;
+
+    for (CachedTile& tile : TileCache)
+    {
+        if (tile.Image == image)
+        {
+            EvictTile(tile);
+            tile.LastUsedFrame = -1;
+        }
+    }
+
+    MemFree(image);
+}
+
+// the tile textures are async images, unloaded with them
+static void UnloadTileCache(void)
+{
+    TileCache.clear();
+    TileCacheIndex.Clear();
+}
+
+int rlImGuiExportTiledImage(Image image, const char* tilePath, int tileSize)
+{
+    if (image.data == nullptr || tilePath == nullptr || tileSize <= 0)
+        return 0;
+
+    Image level = ImageCopy(image);
+    int levels = 0;
+    bool exported = true;
+
+    while (exported)
+    {
+        for (int y = 0; y * tileSize < level.height && exported; y++)
+        {
+            for (int x = 0; x * tileSize < level.width && exported; x++)
+            {
+                Rectangle rect = { float(x * tileSize), float(y * tileSize),
+                    float(std::min(tileSize, level.width - x * tileSize)), float(std::min(tileSize, level.height - y * tileSize)) };
+
+                char path[1024];
+                snprintf(path, sizeof(path), tilePath, levels, x, y);
+                MakeDirectory(GetDirectoryPath(path));
+
+                Image tile = ImageFromImage(level, rect);
+                exported = ExportImage(tile, path);
+                UnloadImage(tile);
+            }
+        }
+        levels++;
+
+        if (level.width <= tileSize && level.height <= tileSize)
+            break;
+        ImageResize(&level, std::max(1, (level.width + 1) / 2), std::max(1, (level.height + 1) / 2));
+    }
+
+    UnloadImage(level);
+    return exported ? levels : 0;
+}
+
+void rlImGuiTiledImageRect(const rlImGuiTiledImage* image, int destWidth, int destHeight, Rectangle sourceRect)
+{
+    if (!image)
+        return;
+
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImVec2 size = ImVec2(float(destWidth), float(destHeight));
+    ImGui::Dummy(size);
+
+    if (ImGui::IsItemVisible())
+        DrawTiledImage(ImGui::GetWindowDrawList(), image, pos, ImVec2(pos.x + size.x, pos.y + size.y), sourceRect);
+}
+
+void rlImGuiTiledImageViewer(const char* name, rlImGuiTiledImage* image, Vector2 size)
+{
+    if (!image)
+        return;
+
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+
+    ImVec2 area = ImGui::GetContentRegionAvail();
+    ImVec2 viewSize(size.x > 0 ? size.x : area.x, size.y > 0 ? size.y : area.y);
+    if (viewSize.x <= 0 || viewSize.y <= 0)
+        return;
+
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton(name, viewSize, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonMiddle);
+
+    float fitScale = std::min(viewSize.x / image->Width, viewSize.y / image->Height);
+    if (image->ViewScale <= 0 || (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)))
+    {
+        image->ViewScale = fitScale;
+        image->ViewCenter = Vector2{ image->Width * 0.5f, image->Height * 0.5f };
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    if (ImGui::IsItemActive() && (io.MouseDelta.x != 0 || io.MouseDelta.y != 0))
+    {
+        image->ViewCenter.x -= io.MouseDelta.x / image->ViewScale;
+        image->ViewCenter.y -= io.MouseDelta.y / image->ViewScale;
+    }
+
+    // zooms around the image pixel under the mouse, from the whole image to 16 screen pixels per image pixel
+    if (ImGui::IsItemHovered() && io.MouseWheel != 0)
+    {
+        ImVec2 mouse(io.MousePos.x - pos.x - viewSize.x * 0.5f, io.MousePos.y - pos.y - viewSize.y * 0.5f);
+        float imageX = image->ViewCenter.x + mouse.x / image->ViewScale;
+        float imageY = image->ViewCenter.y + mouse.y / image->ViewScale;
+
+        image->ViewScale = std::max(std::min(fitScale, 1.0f), std::min(image->ViewScale * powf(1.2f, io.MouseWheel), 16.0f));
+        image->ViewCenter.x = imageX - mouse.x / image->ViewScale;
+        image->ViewCenter.y = imageY - mouse.y / image->ViewScale;
+    }
+
+    Rectangle source = { image->ViewCenter.x - viewSize.x * 0.5f / image->ViewScale, image->ViewCenter.y - viewSize.y * 0.5f / image->ViewScale,
+        viewSize.x / image->ViewScale, viewSize.y / image->ViewScale };
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 end(pos.x + viewSize.x, pos.y + viewSize.y);
+    drawList->AddRectFilled(pos, end, ImGui::GetColorU32(ImGuiCol_FrameBg));
+    DrawTiledImage(drawList, image, pos, end, source);
+}
+
+enum class AsyncImageState
+{
+    Queued,
+    Decoded,                        // pixels ready for upload, in DecodedImages
+    Uploading,
+    Ready,
+    Failed,
+    Evicted,                        // atlas slot given to another, or unloaded, decoded again when drawn
+    Unloading,                      // unloaded once the frames that drew it are rendered, unless drawn again
+};
+
+// one file requested with rlImGuiImageAsync, allocated on its own so draw commands can point at its texture
+struct AsyncImage
+{
+    char* Path = nullptr;
+    std::atomic<AsyncImageState> State{ AsyncImageState::Queued };
+    Image Pixels = { 0 };           // written by the worker before State leaves Queued
+    Texture2D Texture = { 0 };
+    int UploadedRows = 0;
+    int LastUsedFrame = 0;
+    bool Discard = false;           // unloaded while a worker decodes it, guarded by ImageJobLock
+    int Users = 0;                  // cached tiles holding it, it is not deleted while held
+
+    ImGuiID Key = 0;
+    AsyncImage* NextWithKey = nullptr;  // the next image whose path hashes to the same key
+
+    bool Thumbnail = false;         // scaled down by the worker and uploaded to a slot of the thumbnail atlas
+    Texture2D Source = { 0 };       // for rlImGuiImagePacked, the texture copied into the slot instead of a file
+    int Slot = -1;
+    ImVec2 Uv0, Uv1;
+};
+
+static ImVector<AsyncImage*> AsyncImages;
+static ImGuiStorage AsyncImageIndex;   // path hash -> first AsyncImage with that key
+static int IdleImagesCheckFrame = 0;
+static ImGuiStorage PackedImageIndex;  // texture id -> AsyncImage of rlImGuiImagePacked
+static float ImageUploadBudget = 2.0f;  // milliseconds per frame
+
+static std::thread ImageWorkers[4];
+static int ImageWorkerCount = 0;
+static std::mutex ImageJobLock;
+static std::condition_variable ImageJobSignal;
+static ImVector<AsyncImage*> ImageJobs;        // waiting to be decoded, guarded by ImageJobLock
+static ImVector<AsyncImage*> DecodedImages;    // waiting to be uploaded, guarded by ImageJobLock
+static ImVector<AsyncImage*> UnloadingImages;
+static ImVector<Texture2D> UnloadingTextures;   // partial uploads of released images, guarded by ImageJobLock
+static bool ImageWorkersStop = false;
+
+static void ImageWorker(void)
+{
+    std::unique_lock<std::mutex> lock(ImageJobLock);
+    for (;;)
+    {
+        ImageJobSignal.wait(lock, [] { return ImageWorkersStop || !ImageJobs.empty(); });
+        if (ImageWorkersStop)
+            return;
+
+        AsyncImage* image = ImageJobs[0];
+        ImageJobs.erase(ImageJobs.begin());
+
+        // decoding is the slow part, and only touches this image
+        lock.unlock();
+        Image pixels = FileExists(image->Path) ? LoadImage(image->Path) : Image{ 0 };
+        if (image->Thumbnail && pixels.data != nullptr)
+        {
+            // compressed images can not be converted to go into the atlas
+            ImageFormat(&pixels, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            if (pixels.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+            {
+                UnloadImage(pixels);
+                pixels = Image{ 0 };
+            }
+
+            // a pixel of padding keeps filtering from reading the neighbouring slots
+            constexpr int fit = RLIMGUI_THUMBNAIL_SIZE - 2;
+            if (pixels.data != nullptr && (pixels.width > fit || pixels.height > fit))
+            {
+                float scale = std::min(float(fit) / pixels.width, float(fit) / pixels.height);
+                ImageResize(&pixels, std::max(1, int(pixels.width * scale)), std::max(1, int(pixels.height * scale)));
+            }
+        }
+        lock.lock();
+
+        if (image->Discard)
+        {
+            if (pixels.data != nullptr)
+                UnloadImage(pixels);
+            image->Discard = false;
+            image->State = AsyncImageState::Evicted;
+            continue;
+        }
+
+        image->Pixels = pixels;
+        image->State = (pixels.data != nullptr) ? AsyncImageState::Decoded : AsyncImageState::Failed;
+        if (image->State == AsyncImageState::Decoded)
+            DecodedImages.push_back(image);
+    }
+}
+
+static void StartImageWorkers(void)
+{
+    if (ImageWorkerCount > 0)
+        return;
+
+    int workers = RLIMGUI_IMAGE_WORKERS;
+    if (workers <= 0)
+        workers = int(std::thread::hardware_concurrency()) - 1;
+    workers = std::max(1, std::min(workers, int(sizeof(ImageWorkers) / sizeof(ImageWorkers[0]))));
+
+    ImageWorkersStop = false;
+    for (int i = 0; i < workers; i++)
+        ImageWorkers[i] = std::thread(ImageWorker);
+    ImageWorkerCount = workers;
+}
+
+static void StopImageWorkers(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(ImageJobLock);
+        ImageWorkersStop = true;
+        ImageJobs.clear();
+    }
+    ImageJobSignal.notify_all();
+
+    for (int i = 0; i < ImageWorkerCount; i++)
+        ImageWorkers[i].join();
+    ImageWorkerCount = 0;
+}
+
+static void FreeAsyncImage(AsyncImage* image)
+{
+    if (image->Pixels.data != nullptr)
+        UnloadImage(image->Pixels);
+    if (image->Texture.id != 0)
+        UnloadTexture(image->Texture);
+
+    MemFree(image->Path);
+    IM_DELETE(image);
+}
+
+static void QueueAsyncImage(AsyncImage* image)
+{
+    {
+        std::lock_guard<std::mutex> lock(ImageJobLock);
+        image->State = AsyncImageState::Queued;
+        ImageJobs.push_back(image);
+    }
+    ImageJobSignal.notify_one();
+}
+
+// the image, or the thumbnail, of a file, queued for decoding the first time it is asked for
+static ImGuiID GetAsyncImageKey(const char* fileName, bool thumbnail)
+{
+    return ImGuiID(HashBytes(fileName, strlen(fileName), thumbnail ? 1 : 0));
+}
+
+static AsyncImage* FindAsyncImage(const char* fileName, bool thumbnail)
+{
+    // paths whose hashes collide are chained
+    AsyncImage* image = (AsyncImage*)AsyncImageIndex.GetVoidPtr(GetAsyncImageKey(fileName, thumbnail));
+    while (image != nullptr && (image->Thumbnail != thumbnail || strcmp(image->Path, fileName) != 0))
+        image = image->NextWithKey;
+
+    return image;
+}
+
+static AsyncImage* GetAsyncImage(const char* fileName, bool thumbnail)
+{
+    AsyncImage* image = FindAsyncImage(fileName, thumbnail);
+    if (image != nullptr)
+        return image;
+
+    StartImageWorkers();
+
+    image = IM_NEW(AsyncImage)();
+    size_t length = strlen(fileName) + 1;
+    image->Path = (char*)MemAlloc((unsigned int)length);
+    memcpy(image->Path, fileName, length);
+    image->Thumbnail = thumbnail;
+    image->Key = GetAsyncImageKey(fileName, thumbnail);
+    image->NextWithKey = (AsyncImage*)AsyncImageIndex.GetVoidPtr(image->Key);
+
+    AsyncImages.push_back(image);
+    AsyncImageIndex.SetVoidPtr(image->Key, image);
+
+    QueueAsyncImage(image);
+    return image;
+}
+
+constexpr int ThumbnailsPerRow = RLIMGUI_THUMBNAIL_PAGE_SIZE / RLIMGUI_THUMBNAIL_SIZE;
+constexpr int ThumbnailsPerPage = ThumbnailsPerRow * ThumbnailsPerRow;
+
+static Texture2D ThumbnailPages[RLIMGUI_THUMBNAIL_PAGES];   // draw commands point at these
+static ImVector<AsyncImage*> ThumbnailSlots;                // slot -> thumbnail in it, null when free
+static ImVector<int> ThumbnailSlotLastUsed;                 // for free slots, the last frame that drew from them
+static ImVector<unsigned int> ThumbnailScratch;             // one slot of RGBA pixels, padding included
+
+// packed textures are copied into the pages on the GPU, through a framebuffer bound for reading only so the
+// framebuffer raylib draws to is left alone. rlgl only binds framebuffers for both, the calls are loaded here
+#if defined(RLIMGUI_GL_LOADER) && !defined(GRAPHICS_API_OPENGL_ES2) && !defined(GRAPHICS_API_OPENGL_21)
+#define RLIMGUI_GPU_PACKING
+
+struct PackingFunctions
+{
+    void (RLIMGUI_GLAPI *GenFramebuffers)(int count, unsigned int* framebuffers);
+    void (RLIMGUI_GLAPI *DeleteFramebuffers)(int count, const unsigned int* framebuffers);
+    void (RLIMGUI_GLAPI *BindFramebuffer)(unsigned int target, unsigned int framebuffer);
+    void (RLIMGUI_GLAPI *FramebufferTexture2D)(unsigned int target, unsigned int attachment, unsigned int textureTarget, unsigned int texture, int level);
+    unsigned int (RLIMGUI_GLAPI *CheckFramebufferStatus)(unsigned int target);
+    void (RLIMGUI_GLAPI *GetIntegerv)(unsigned int name, int* data);
+    void (RLIMGUI_GLAPI *CopyTexSubImage2D)(unsigned int target, int level, int x, int y, int sourceX, int sourceY, int width, int height);
+};
+
+static PackingFunctions PackingGL = { 0 };
+static unsigned int PackingFramebuffer = 0;
+
+static bool LoadPackingFunctions(void)
+{
+    if (PackingFramebuffer != 0)
+        return true;
+
+    PackingGL.GenFramebuffers = (decltype(PackingGL.GenFramebuffers))glfwGetProcAddress("glGenFramebuffers");
+    PackingGL.DeleteFramebuffers = (decltype(PackingGL.DeleteFramebuffers))glfwGetProcAddress("glDeleteFramebuffers");
+    PackingGL.BindFramebuffer = (decltype(PackingGL.BindFramebuffer))glfwGetProcAddress("glBindFramebuffer");
+    PackingGL.FramebufferTexture2D = (decltype(PackingGL.FramebufferTexture2D))glfwGetProcAddress("glFramebufferTexture2D");
+    PackingGL.CheckFramebufferStatus = (decltype(PackingGL.CheckFramebufferStatus))glfwGetProcAddress("glCheckFramebufferStatus");
+    PackingGL.GetIntegerv = (decltype(PackingGL.GetIntegerv))glfwGetProcAddress("glGetIntegerv");
+    PackingGL.CopyTexSubImage2D = (decltype(PackingGL.CopyTexSubImage2D))glfwGetProcAddress("glCopyTexSubImage2D");
+
+    if (!PackingGL.GenFramebuffers || !PackingGL.DeleteFramebuffers || !PackingGL.BindFramebuffer || !PackingGL.FramebufferTexture2D
+        || !PackingGL.CheckFramebufferStatus || !PackingGL.GetIntegerv || !PackingGL.CopyTexSubImage2D)
+        return false;
+
+    PackingGL.GenFramebuffers(1, &PackingFramebuffer);
+    return PackingFramebuffer != 0;
+}
+
+static void UnloadPackingFramebuffer(void)
+{
+    if (PackingFramebuffer != 0)
+        PackingGL.DeleteFramebuffers(1, &PackingFramebuffer);
+    PackingFramebuffer = 0;
+}
+#endif
+
+// finds a slot for a thumbnail: a free one, a new one while there are pages left, or the least recently drawn one
+static int AllocateThumbnailSlot(void)
+{
+    // thumbnails drawn in the last frame may still be referenced by draw data that is not rendered yet
+    int frame = ImGui::GetFrameCount();
+    for (int slot = 0; slot < ThumbnailSlots.Size; slot++)
+    {
+        if (ThumbnailSlots[slot] == nullptr && ThumbnailSlotLastUsed[slot] < frame - 1)
+            return slot;
+    }
+
+    if (ThumbnailSlots.Size < RLIMGUI_THUMBNAIL_PAGES * ThumbnailsPerPage)
+    {
+        int page = ThumbnailSlots.Size / ThumbnailsPerPage;
+        if (ThumbnailPages[page].id == 0)
+        {
+            Texture2D& texture = ThumbnailPages[page];
+            texture.id = rlLoadTexture(nullptr, RLIMGUI_THUMBNAIL_PAGE_SIZE, RLIMGUI_THUMBNAIL_PAGE_SIZE, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+            texture.width = RLIMGUI_THUMBNAIL_PAGE_SIZE;
+            texture.height = RLIMGUI_THUMBNAIL_PAGE_SIZE;
+            texture.mipmaps = 1;
+            texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+            SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+        }
+
+        ThumbnailSlots.push_back(nullptr);
+        ThumbnailSlotLastUsed.push_back(std::numeric_limits<int>::min());
+        return ThumbnailSlots.Size - 1;
+    }
+
+    int oldest = -1;
+    for (int slot = 0; slot < ThumbnailSlots.Size; slot++)
+    {
+        if (ThumbnailSlots[slot] == nullptr)
+            continue;
+
+        int lastUsed = ThumbnailSlots[slot]->LastUsedFrame;
+        if (lastUsed < frame - 1 && (oldest < 0 || lastUsed < ThumbnailSlots[oldest]->LastUsedFrame))
+            oldest = slot;
+    }
+
+    if (oldest >= 0)
+    {
+        ThumbnailSlots[oldest]->Slot = -1;
+        ThumbnailSlots[oldest]->State = AsyncImageState::Evicted;
+        ThumbnailSlots[oldest] = nullptr;
+    }
+    return oldest;
+}
+
+// top left corner of a slot in its page, in texels
+static void GetThumbnailSlotOrigin(int slot, int* x, int* y)
+{
+    int cell = slot % ThumbnailsPerPage;
+    *x = (cell % ThumbnailsPerRow) * RLIMGUI_THUMBNAIL_SIZE;
+    *y = (cell / ThumbnailsPerRow) * RLIMGUI_THUMBNAIL_SIZE;
+}
+
+// gives the slot to an image whose width x height texels start one texel into it, past the padding
+static void PlaceThumbnail(AsyncImage* image, int slot, int width, int height)
+{
+    int slotX, slotY;
+    GetThumbnailSlotOrigin(slot, &slotX, &slotY);
+    float x = float(slotX + 1);
+    float y = float(slotY + 1);
+
+    image->Slot = slot;
+    image->Uv0 = ImVec2(x / RLIMGUI_THUMBNAIL_PAGE_SIZE, y / RLIMGUI_THUMBNAIL_PAGE_SIZE);
+    image->Uv1 = ImVec2((x + width) / RLIMGUI_THUMBNAIL_PAGE_SIZE, (y + height) / RLIMGUI_THUMBNAIL_PAGE_SIZE);
+    ThumbnailSlots[slot] = image;
+    image->State = AsyncImageState::Ready;
+}
+
+// copies a decoded thumbnail into the atlas, false when every slot is in use
+static bool UploadThumbnail(AsyncImage* image)
+{
+    int slot = AllocateThumbnailSlot();
+    if (slot < 0)
+        return false;
+
+    // the whole slot is written, with the edge texels repeated into the padding, so filtering at the border
+    // never reads what a previous thumbnail or the uninitialized page left there
+    Image& pixels = image->Pixels;
+    constexpr int slotSize = RLIMGUI_THUMBNAIL_SIZE;
+    ThumbnailScratch.resize(slotSize * slotSize);
+    memset(ThumbnailScratch.Data, 0, ThumbnailScratch.size_in_bytes());
+
+    const unsigned int* source = (const unsigned int*)pixels.data;
+    for (int row = 0; row < std::min(pixels.height + 2, slotSize); row++)
+    {
+        const unsigned int* sourceRow = source + std::max(0, std::min(row - 1, pixels.height - 1)) * pixels.width;
+        unsigned int* slotRow = ThumbnailScratch.Data + row * slotSize;
+        for (int column = 0; column < std::min(pixels.width + 2, slotSize); column++)
+            slotRow[column] = sourceRow[std::max(0, std::min(column - 1, pixels.width - 1))];
+    }
+
+    int slotX, slotY;
+    GetThumbnailSlotOrigin(slot, &slotX, &slotY);
+    UpdateTextureRec(ThumbnailPages[slot / ThumbnailsPerPage], Rectangle{ float(slotX), float(slotY), float(slotSize), float(slotSize) }, ThumbnailScratch.Data);
+
+    PlaceThumbnail(image, slot, pixels.width, pixels.height);
+
+    UnloadImage(pixels);
+    pixels = Image{ 0 };
+    return true;
+}
+
+// copies a packed texture into a slot on the GPU, with its edge texels repeated into the padding.
+// False when every slot is in use, the image fails when its texture can not be read through a framebuffer
+static bool CopyPackedTexture(AsyncImage* image)
+{
+#ifdef RLIMGUI_GPU_PACKING
+    constexpr unsigned int textureTarget = 0x0DE1;         // GL_TEXTURE_2D
+    constexpr unsigned int readFramebuffer = 0x8CA8;       // GL_READ_FRAMEBUFFER
+    constexpr unsigned int readBinding = 0x8CAA;           // GL_READ_FRAMEBUFFER_BINDING
+    constexpr unsigned int colorAttachment = 0x8CE0;       // GL_COLOR_ATTACHMENT0
+    constexpr unsigned int complete = 0x8CD5;              // GL_FRAMEBUFFER_COMPLETE
+
+    if (!LoadPackingFunctions())
+    {
+        image->State = AsyncImageState::Failed;
+        return true;
+    }
+
+    int slot = AllocateThumbnailSlot();
+    if (slot < 0)
+        return false;
+
+    // geometry rlgl has not drawn yet may sample the page that is about to change
+    rlDrawRenderBatchActive();
+
+    int previous = 0;
+    PackingGL.GetIntegerv(readBinding, &previous);
+    PackingGL.BindFramebuffer(readFramebuffer, PackingFramebuffer);
+    PackingGL.FramebufferTexture2D(readFramebuffer, colorAttachment, textureTarget, image->Source.id, 0);
+
+    const Texture2D& source = image->Source;
+    bool readable = PackingGL.CheckFramebufferStatus(readFramebuffer) == complete;
+    if (readable)
+    {
+        int slotX, slotY;
+        GetThumbnailSlotOrigin(slot, &slotX, &slotY);
+
+        // the texture one texel into the slot, then its edge rows, columns and corners once more around it
+        rlEnableTexture(ThumbnailPages[slot / ThumbnailsPerPage].id);
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                int sourceX = (dx > 0) ? source.width - 1 : 0;
+                int sourceY = (dy > 0) ? source.height - 1 : 0;
+                int width = (dx == 0) ? source.width : 1;
+                int height = (dy == 0) ? source.height : 1;
+                int x = slotX + 1 + ((dx < 0) ? -1 : (dx > 0) ? source.width : 0);
+                int y = slotY + 1 + ((dy < 0) ? -1 : (dy > 0) ? source.height : 0);
+                PackingGL.CopyTexSubImage2D(textureTarget, 0, x, y, sourceX, sourceY, width, height);
+            }
+        }
+        rlDisableTexture();
+    }
+
+    PackingGL.FramebufferTexture2D(readFramebuffer, colorAttachment, textureTarget, 0, 0);
+    PackingGL.BindFramebuffer(readFramebuffer, (unsigned int)previous);
+
+    // the slot stays free, the texture is drawn on its own
+    if (!readable)
+    {
+        image->State = AsyncImageState::Failed;
+        return true;
+    }
+
+    PlaceThumbnail(image, slot, source.width, source.height);
+    return true;
+#else
+    image->State = AsyncImageState::Failed;
+    return true;
+#endif
+}
+
+// ImGuiStorage has no erase, its pairs are sorted by key
+static void EraseStorageKey(ImGuiStorage& storage, ImGuiID key)
+{
+    ImGuiStoragePair* pair = std::lower_bound(storage.Data.begin(), storage.Data.end(), key,
+        [](const ImGuiStoragePair& entry, ImGuiID value) { return entry.key < value; });
+    if (pair != storage.Data.end() && pair->key == key)
+        storage.Data.erase(pair);
+}
+
+// deletes the entries of files that are unloaded or failed and were not drawn for RLIMGUI_IMAGE_IDLE_FRAMES, so
+// panning a tiled image over a large pyramid does not keep an entry for every tile it ever showed.
+// Packed textures are not deleted, there is one entry per texture of the application
+static void DeleteIdleImages(int frame)
+{
+    for (int i = AsyncImages.Size - 1; i >= 0; i--)
+    {
+        AsyncImage* image = AsyncImages[i];
+        AsyncImageState state = image->State;
+        if (image->Path == nullptr || image->Users > 0 || image->LastUsedFrame >= frame - RLIMGUI_IMAGE_IDLE_FRAMES
+            || (state != AsyncImageState::Evicted && state != AsyncImageState::Failed))
+            continue;
+
+        AsyncImage* first = (AsyncImage*)AsyncImageIndex.GetVoidPtr(image->Key);
+        if (first == image)
+        {
+            if (image->NextWithKey != nullptr)
+                AsyncImageIndex.SetVoidPtr(image->Key, image->NextWithKey);
+            else
+                EraseStorageKey(AsyncImageIndex, image->Key);
+        }
+        else
+        {
+            AsyncImage* previous = first;
+            while (previous->NextWithKey != image)
+                previous = previous->NextWithKey;
+            previous->NextWithKey = image->NextWithKey;
+        }
+
+        AsyncImages[i] = AsyncImages.back();
+        AsyncImages.pop_back();
+        FreeAsyncImage(image);
+    }
+}
+
+// uploads decoded images in strips of rows until the frame's budget is spent, at least one strip per frame,
+// so a large image is spread over several frames instead of stalling one
+static void UploadDecodedImages(void)
+{
+    // textures of unloaded images are released once no draw data in flight can use them
+    int frame = ImGui::GetFrameCount();
+    for (int i = UnloadingImages.Size - 1; i >= 0; i--)
+    {
+        AsyncImage* image = UnloadingImages[i];
+        if (image->State == AsyncImageState::Unloading && image->LastUsedFrame >= frame - 1)
+            continue;
+
+        if (image->State == AsyncImageState::Unloading)
+        {
+            UnloadTexture(image->Texture);
+            image->Texture = Texture2D{ 0 };
+            image->State = AsyncImageState::Evicted;
+        }
+        UnloadingImages.erase(UnloadingImages.begin() + i);
+    }
+
+    // the UI is not being built while this runs, so entries can go
+    if (frame - IdleImagesCheckFrame >= 60)
+    {
+        IdleImagesCheckFrame = frame;
+        DeleteIdleImages(frame);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ImageJobLock);
+        for (const Texture2D& texture : UnloadingTextures)
+            UnloadTexture(texture);
+        UnloadingTextures.clear();
+    }
+
+    constexpr int stripBytes = 256 * 1024;
+    double start = GetTime();
+
+    // workers only append, so the images before next keep their place while the lock is released
+    std::unique_lock<std::mutex> lock(ImageJobLock);
+    int next = 0;
+    while (next < DecodedImages.Size)
+    {
+        AsyncImage* image = DecodedImages[next];
+        lock.unlock();
+
+        if (image->Thumbnail)
+        {
+            // packed textures are copied on the GPU, which needs the GL context like uploading does
+            bool uploaded = image->State == AsyncImageState::Failed || ((image->Source.id != 0) ? CopyPackedTexture(image) : UploadThumbnail(image));
+            lock.lock();
+
+            // with every atlas slot in use it stays queued, and the images behind it go ahead
+            if (!uploaded)
+            {
+                next++;
+                continue;
+            }
+
+            DecodedImages.erase(DecodedImages.begin() + next);
+            if ((GetTime() - start) * 1000.0 >= ImageUploadBudget)
+                break;
+            continue;
+        }
+
+        Image& pixels = image->Pixels;
+
+        // compressed blocks and mipmap chains can not be split into rows, they are uploaded whole
+        if (pixels.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB || pixels.mipmaps > 1)
+        {
+            image->Texture.id = rlLoadTexture(pixels.data, pixels.width, pixels.height, pixels.format, pixels.mipmaps);
+            image->Texture.width = pixels.width;
+            image->Texture.height = pixels.height;
+            image->Texture.mipmaps = pixels.mipmaps;
+            image->Texture.format = pixels.format;
+            SetTextureFilter(image->Texture, TEXTURE_FILTER_BILINEAR);
+
+            UnloadImage(pixels);
+            pixels = Image{ 0 };
+            image->State = (image->Texture.id != 0) ? AsyncImageState::Ready : AsyncImageState::Failed;
+
+            lock.lock();
+            DecodedImages.erase(DecodedImages.begin() + next);
+            if ((GetTime() - start) * 1000.0 >= ImageUploadBudget)
+                break;
+            continue;
+        }
 
-    SetupFontAwesome();
+        if (image->State == AsyncImageState::Decoded)
+        {
+            image->Texture.id = rlLoadTexture(nullptr, pixels.width, pixels.height, pixels.format, 1);
+            image->Texture.width = pixels.width;
+            image->Texture.height = pixels.height;
+            image->Texture.mipmaps = 1;
+            image->Texture.format = pixels.format;
+            SetTextureFilter(image->Texture, TEXTURE_FILTER_BILINEAR);
+            image->UploadedRows = 0;
+            image->State = AsyncImageState::Uploading;
+        }
 
-    SetupMouseCursors();
+        int rowBytes = GetPixelDataSize(pixels.width, 1, pixels.format);
+        int rows = std::max(1, std::min(pixels.height - image->UploadedRows, stripBytes / std::max(1, rowBytes)));
+        Rectangle strip = { 0, float(image->UploadedRows), float(pixels.width), float(rows) };
+        UpdateTextureRec(image->Texture, strip, (const unsigned char*)pixels.data + size_t(image->UploadedRows) * rowBytes);
+        image->UploadedRows += rows;
 
-    SetupBackend();
+        bool done = image->UploadedRows >= pixels.height;
+        if (done)
+        {
+            UnloadImage(pixels);
+            pixels = Image{ 0 };
+            image->State = AsyncImageState::Ready;
+        }
 
-    ReloadFonts();
-}
+        lock.lock();
+        if (done)
+            DecodedImages.erase(DecodedImages.begin() + next);
 
-static void SetupKeymap(void)
-{
-    if (!RaylibKeyMap.empty())
-        return;
-
-    // build up a map of raylib keys to ImGuiKeys
-    RaylibKeyMap[KEY_APOSTROPHE] = ImGuiKey_Apostrophe;
-    RaylibKeyMap[KEY_COMMA] = ImGuiKey_Comma;
-    RaylibKeyMap[KEY_MINUS] = ImGuiKey_Minus;
-    RaylibKeyMap[KEY_PERIOD] = ImGuiKey_Period;
-    RaylibKeyMap[KEY_SLASH] = ImGuiKey_Slash;
-    RaylibKeyMap[KEY_ZERO] = ImGuiKey_0;
-    RaylibKeyMap[KEY_ONE] = ImGuiKey_1;
-    RaylibKeyMap[KEY_TWO] = ImGuiKey_2;
-    RaylibKeyMap[KEY_THREE] = ImGuiKey_3;
-    RaylibKeyMap[KEY_FOUR] = ImGuiKey_4;
-    RaylibKeyMap[KEY_FIVE] = ImGuiKey_5;
-    RaylibKeyMap[KEY_SIX] = ImGuiKey_6;
-    RaylibKeyMap[KEY_SEVEN] = ImGuiKey_7;
-    RaylibKeyMap[KEY_EIGHT] = ImGuiKey_8;
-    RaylibKeyMap[KEY_NINE] = ImGuiKey_9;
-    RaylibKeyMap[KEY_SEMICOLON] = ImGuiKey_Semicolon;
-    RaylibKeyMap[KEY_EQUAL] = ImGuiKey_Equal;
-    RaylibKeyMap[KEY_A] = ImGuiKey_A;
-    RaylibKeyMap[KEY_B] = ImGuiKey_B;
-    RaylibKeyMap[KEY_C] = ImGuiKey_C;
-    RaylibKeyMap[KEY_D] = ImGuiKey_D;
-    RaylibKeyMap[KEY_E] = ImGuiKey_E;
-    RaylibKeyMap[KEY_F] = ImGuiKey_F;
-    RaylibKeyMap[KEY_G] = ImGuiKey_G;
-    RaylibKeyMap[KEY_H] = ImGuiKey_H;
-    RaylibKeyMap[KEY_I] = ImGuiKey_I;
-    RaylibKeyMap[KEY_J] = ImGuiKey_J;
-    RaylibKeyMap[KEY_K] = ImGuiKey_K;
-    RaylibKeyMap[KEY_L] = ImGuiKey_L;
-    RaylibKeyMap[KEY_M] = ImGuiKey_M;
-    RaylibKeyMap[KEY_N] = ImGuiKey_N;
-    RaylibKeyMap[KEY_O] = ImGuiKey_O;
-    RaylibKeyMap[KEY_P] = ImGuiKey_P;
-    RaylibKeyMap[KEY_Q] = ImGuiKey_Q;
-    RaylibKeyMap[KEY_R] = ImGuiKey_R;
-    RaylibKeyMap[KEY_S] = ImGuiKey_S;
-    RaylibKeyMap[KEY_T] = ImGuiKey_T;
-    RaylibKeyMap[KEY_U] = ImGuiKey_U;
-    RaylibKeyMap[KEY_V] = ImGuiKey_V;
-    RaylibKeyMap[KEY_W] = ImGuiKey_W;
-    RaylibKeyMap[KEY_X] = ImGuiKey_X;
-    RaylibKeyMap[KEY_Y] = ImGuiKey_Y;
-    RaylibKeyMap[KEY_Z] = ImGuiKey_Z;
-    RaylibKeyMap[KEY_SPACE] = ImGuiKey_Space;
-    RaylibKeyMap[KEY_ESCAPE] = ImGuiKey_Escape;
-    RaylibKeyMap[KEY_ENTER] = ImGuiKey_Enter;
-    RaylibKeyMap[KEY_TAB] = ImGuiKey_Tab;
-    RaylibKeyMap[KEY_BACKSPACE] = ImGuiKey_Backspace;
-    RaylibKeyMap[KEY_INSERT] = ImGuiKey_Insert;
-    RaylibKeyMap[KEY_DELETE] = ImGuiKey_Delete;
-    RaylibKeyMap[KEY_RIGHT] = ImGuiKey_RightArrow;
-    RaylibKeyMap[KEY_LEFT] = ImGuiKey_LeftArrow;
-    RaylibKeyMap[KEY_DOWN] = ImGuiKey_DownArrow;
-    RaylibKeyMap[KEY_UP] = ImGuiKey_UpArrow;
-    RaylibKeyMap[KEY_PAGE_UP] = ImGuiKey_PageUp;
-    RaylibKeyMap[KEY_PAGE_DOWN] = ImGuiKey_PageDown;
-    RaylibKeyMap[KEY_HOME] = ImGuiKey_Home;
-    RaylibKeyMap[KEY_END] = ImGuiKey_End;
-    RaylibKeyMap[KEY_CAPS_LOCK] = ImGuiKey_CapsLock;
-    RaylibKeyMap[KEY_SCROLL_LOCK] = ImGuiKey_ScrollLock;
-    RaylibKeyMap[KEY_NUM_LOCK] = ImGuiKey_NumLock;
-    RaylibKeyMap[KEY_PRINT_SCREEN] = ImGuiKey_PrintScreen;
-    RaylibKeyMap[KEY_PAUSE] = ImGuiKey_Pause;
-    RaylibKeyMap[KEY_F1] = ImGuiKey_F1;
-    RaylibKeyMap[KEY_F2] = ImGuiKey_F2;
-    RaylibKeyMap[KEY_F3] = ImGuiKey_F3;
-    RaylibKeyMap[KEY_F4] = ImGuiKey_F4;
-    RaylibKeyMap[KEY_F5] = ImGuiKey_F5;
-    RaylibKeyMap[KEY_F6] = ImGuiKey_F6;
-    RaylibKeyMap[KEY_F7] = ImGuiKey_F7;
-    RaylibKeyMap[KEY_F8] = ImGuiKey_F8;
-    RaylibKeyMap[KEY_F9] = ImGuiKey_F9;
-    RaylibKeyMap[KEY_F10] = ImGuiKey_F10;
-    RaylibKeyMap[KEY_F11] = ImGuiKey_F11;
-    RaylibKeyMap[KEY_F12] = ImGuiKey_F12;
-    RaylibKeyMap[KEY_LEFT_SHIFT] = ImGuiKey_LeftShift;
-    RaylibKeyMap[KEY_LEFT_CONTROL] = ImGuiKey_LeftCtrl;
-    RaylibKeyMap[KEY_LEFT_ALT] = ImGuiKey_LeftAlt;
-    RaylibKeyMap[KEY_LEFT_SUPER] = ImGuiKey_LeftSuper;
-    RaylibKeyMap[KEY_RIGHT_SHIFT] = ImGuiKey_RightShift;
-    RaylibKeyMap[KEY_RIGHT_CONTROL] = ImGuiKey_RightCtrl;
-    RaylibKeyMap[KEY_RIGHT_ALT] = ImGuiKey_RightAlt;
-    RaylibKeyMap[KEY_RIGHT_SUPER] = ImGuiKey_RightSuper;
-    RaylibKeyMap[KEY_KB_MENU] = ImGuiKey_Menu;
-    RaylibKeyMap[KEY_LEFT_BRACKET] = ImGuiKey_LeftBracket;
-    RaylibKeyMap[KEY_BACKSLASH] = ImGuiKey_Backslash;
-    RaylibKeyMap[KEY_RIGHT_BRACKET] = ImGuiKey_RightBracket;
-    RaylibKeyMap[KEY_GRAVE] = ImGuiKey_GraveAccent;
-    RaylibKeyMap[KEY_KP_0] = ImGuiKey_Keypad0;
-    RaylibKeyMap[KEY_KP_1] = ImGuiKey_Keypad1;
-    RaylibKeyMap[KEY_KP_2] = ImGuiKey_Keypad2;
-    RaylibKeyMap[KEY_KP_3] = ImGuiKey_Keypad3;
-    RaylibKeyMap[KEY_KP_4] = ImGuiKey_Keypad4;
-    RaylibKeyMap[KEY_KP_5] = ImGuiKey_Keypad5;
-    RaylibKeyMap[KEY_KP_6] = ImGuiKey_Keypad6;
-    RaylibKeyMap[KEY_KP_7] = ImGuiKey_Keypad7;
-    RaylibKeyMap[KEY_KP_8] = ImGuiKey_Keypad8;
-    RaylibKeyMap[KEY_KP_9] = ImGuiKey_Keypad9;
-    RaylibKeyMap[KEY_KP_DECIMAL] = ImGuiKey_KeypadDecimal;
-    RaylibKeyMap[KEY_KP_DIVIDE] = ImGuiKey_KeypadDivide;
-    RaylibKeyMap[KEY_KP_MULTIPLY] = ImGuiKey_KeypadMultiply;
-    RaylibKeyMap[KEY_KP_SUBTRACT] = ImGuiKey_KeypadSubtract;
-    RaylibKeyMap[KEY_KP_ADD] = ImGuiKey_KeypadAdd;
-    RaylibKeyMap[KEY_KP_ENTER] = ImGuiKey_KeypadEnter;
-    RaylibKeyMap[KEY_KP_EQUAL] = ImGuiKey_KeypadEqual;
+        if ((GetTime() - start) * 1000.0 >= ImageUploadBudget)
+            break;
+    }
 }
 
-static void SetupGlobals(void)
+static void UnloadAsyncImages(void)
 {
-    LastFrameFocused = IsWindowFocused();
-    LastControlPressed = false;
-    LastShiftPressed = false;
-    LastAltPressed = false;
-    LastSuperPressed = false;
+    StopImageWorkers();
+
+    for (AsyncImage* image : AsyncImages)
+        FreeAsyncImage(image);
+
+    AsyncImages.clear();
+    AsyncImageIndex.Clear();
+    IdleImagesCheckFrame = 0;
+    PackedImageIndex.Clear();
+    DecodedImages.clear();
+    UnloadingImages.clear();
+    for (const Texture2D& texture : UnloadingTextures)
+        UnloadTexture(texture);
+    UnloadingTextures.clear();
+    ThumbnailScratch.clear();
+
+    for (Texture2D& page : ThumbnailPages)
+    {
+        if (page.id != 0)
+            UnloadTexture(page);
+        page = Texture2D{ 0 };
+    }
+    ThumbnailSlots.clear();
+    ThumbnailSlotLastUsed.clear();
+
+#ifdef RLIMGUI_GPU_PACKING
+    UnloadPackingFramebuffer();
+#endif
 }
 
-void rlImGuiBeginInitImGui(void)
+bool rlImGuiImageAsync(const char* fileName, Vector2 size)
 {
-    SetupGlobals();
-    if (GlobalContext == nullptr)
-        GlobalContext = ImGui::CreateContext(nullptr);
-    SetupKeymap();
-
-    ImGuiIO& io = ImGui::GetIO();
+    if (fileName == nullptr)
+        return false;
 
-    ImFontConfig defaultConfig;
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
 
-	static constexpr int DefaultFonSize = 13;
+    const Texture* texture = nullptr;
+    ImVec2 itemSize(size.x > 0 ? size.x : 64.0f, size.y > 0 ? size.y : 64.0f);
 
-    defaultConfig.SizePixels = DefaultFonSize;
-#if !defined(__APPLE__)
-	if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
-        defaultConfig.SizePixels = ceilf(defaultConfig.SizePixels * GetWindowScaleDPI().y);
+    // only images that are on screen are requested, a long scrolled list loads as it comes into view
+    if (ImGui::IsRectVisible(itemSize))
+        texture = rlImGuiGetImageAsync(fileName);
 
-    defaultConfig.RasterizerMultiply = GetWindowScaleDPI().y;
-#endif
+    if (texture != nullptr)
+    {
+        // a missing dimension follows the aspect ratio of the image
+        if (size.x <= 0 && size.y <= 0)
+            itemSize = ImVec2(float(texture->width), float(texture->height));
+        else if (size.x <= 0)
+            itemSize.x = size.y * texture->width / texture->height;
+        else if (size.y <= 0)
+            itemSize.y = size.x * texture->height / texture->width;
+
+        ImGui::Image((ImTextureID)texture, itemSize);
+        return true;
+    }
 
-    defaultConfig.PixelSnapH = true;
-    io.Fonts->AddFontDefault(&defaultConfig);
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(itemSize);
+    ImGui::GetWindowDrawList()->AddRectFilled(pos, ImVec2(pos.x + itemSize.x, pos.y + itemSize.y), ImGui::GetColorU32(ImGuiCol_FrameBg));
+    return false;
 }
 
-void rlImGuiSetup(bool dark)
+const Texture* rlImGuiGetImageAsync(const char* fileName)
 {
-    rlImGuiBeginInitImGui();
-
-    if (dark)
-        ImGui::StyleColorsDark();
-    else
-        ImGui::StyleColorsLight();
+    if (fileName == nullptr)
+        return nullptr;
 
-    rlImGuiEndInitImGui();
+    return UseAsyncImage(GetAsyncImage(fileName, false));
 }
 
-void rlImGuiReloadFonts(void)
+void rlImGuiUnloadImageAsync(const char* fileName)
 {
-    ImGui::SetCurrentContext(GlobalContext);
+    if (fileName == nullptr)
+        return;
 
-    ReloadFonts();
+    AsyncImage* image = FindAsyncImage(fileName, false);
+    if (image != nullptr)
+        ReleaseAsyncImage(image);
 }
 
-void rlImGuiBegin(void)
+// marks a full size image as drawn this frame, the texture once it is ready
+static const Texture2D* UseAsyncImage(AsyncImage* image)
 {
-    ImGui::SetCurrentContext(GlobalContext);
-    rlImGuiBeginDelta(GetFrameTime());
-}
+    image->LastUsedFrame = ImGui::GetFrameCount();
 
-void rlImGuiBeginDelta(float deltaTime)
-{
-    ImGui::SetCurrentContext(GlobalContext);
+    // asked for again, an unload that has not happened yet is called off, one that has is loaded again
+    if (image->State == AsyncImageState::Unloading)
+        image->State = AsyncImageState::Ready;
+    else if (image->State == AsyncImageState::Evicted)
+        QueueAsyncImage(image);
 
-    ImGuiNewFrame(deltaTime);
-    ImGui_ImplRaylib_ProcessEvents();
-    ImGui::NewFrame();
+    return (image->State == AsyncImageState::Ready) ? &image->Texture : nullptr;
 }
 
-void rlImGuiEnd(void)
+// held images keep their entry while they are not drawn, see DeleteIdleImages
+static void HoldAsyncImage(AsyncImage* image, bool held)
 {
-    ImGui::SetCurrentContext(GlobalContext);
-    ImGui::Render();
-    ImGui_ImplRaylib_RenderDrawData(ImGui::GetDrawData());
+    image->Users += held ? 1 : -1;
 }
 
-void rlImGuiShutdown(void)
+static void ReleaseAsyncImage(AsyncImage* image)
 {
-    if (GlobalContext == nullptr)
-        return;
-
-    ImGui::SetCurrentContext(GlobalContext);
-    ImGui_ImplRaylib_Shutdown();
-
-    ImGui::DestroyContext(GlobalContext);
-    GlobalContext = nullptr;
+    std::lock_guard<std::mutex> lock(ImageJobLock);
+    switch (image->State.load())
+    {
+    case AsyncImageState::Queued:
+        // taken by a worker when it is no longer in the queue, the worker drops it when done
+        if (ImageJobs.find_erase(image))
+            image->State = AsyncImageState::Evicted;
+        else
+            image->Discard = true;
+        break;
+
+    case AsyncImageState::Decoded:
+    case AsyncImageState::Uploading:
+        // never drawn while uploading, so the partial texture needs no frame guard. This may run on the thread
+        // building the UI, the texture is unloaded with the others on the render thread
+        DecodedImages.find_erase(image);
+        UnloadImage(image->Pixels);
+        image->Pixels = Image{ 0 };
+        if (image->Texture.id != 0)
+            UnloadingTextures.push_back(image->Texture);
+        image->Texture = Texture2D{ 0 };
+        image->State = AsyncImageState::Evicted;
+        break;
+
+    case AsyncImageState::Ready:
+        image->State = AsyncImageState::Unloading;
+        UnloadingImages.push_back(image);
+        break;
+
+    default:
+        break;
+    }
 }
 
-void rlImGuiImage(const Texture* image)
+bool rlImGuiIsImageAsyncFailed(const char* fileName)
 {
-    if (!image)
-        return;
-    
-    if (GlobalContext)
-        ImGui::SetCurrentContext(GlobalContext);
-    
-    ImGui::Image((ImTextureID)image, ImVec2(float(image->width), float(image->height)));
-}
+    if (fileName == nullptr)
+        return true;
 
-bool rlImGuiImageButton(const char* name, const Texture* image)
-{
-    if (!image)
-        return false;
-    
-    if (GlobalContext)
-        ImGui::SetCurrentContext(GlobalContext);
-    
-    return ImGui::ImageButton(name, (ImTextureID)image, ImVec2(float(image->width), float(image->height)));
+    return GetAsyncImage(fileName, false)->State == AsyncImageState::Failed;
 }
 
-bool rlImGuiImageButtonSize(const char* name, const Texture* image, Vector2 size)
+void rlImGuiSetImageUploadBudget(float milliseconds)
 {
-    if (!image)
-        return false;
-    
-    if (GlobalContext)
-        ImGui::SetCurrentContext(GlobalContext);
-   
-    return ImGui::ImageButton(name, (ImTextureID)image, ImVec2(size.x, size.y));
+    ImageUploadBudget = std::max(0.0f, milliseconds);
 }
 
-void rlImGuiImageSize(const Texture* image, int width, int height)
+// draws the thumbnail of a file fitted and centered in a cell, or a placeholder while it loads
+static void DrawThumbnail(ImDrawList* drawList, const char* fileName, ImVec2 pos, float size)
 {
-    if (!image)
+    AsyncImage* image = GetAsyncImage(fileName, true);
+    image->LastUsedFrame = ImGui::GetFrameCount();
+    if (image->State == AsyncImageState::Evicted)
+        QueueAsyncImage(image);
+
+    if (image->State != AsyncImageState::Ready)
+    {
+        drawList->AddRectFilled(pos, ImVec2(pos.x + size, pos.y + size), ImGui::GetColorU32(ImGuiCol_FrameBg));
         return;
-    
-    if (GlobalContext)
-        ImGui::SetCurrentContext(GlobalContext);
-    
-    ImGui::Image((ImTextureID)image, ImVec2(float(width), float(height)));
+    }
+
+    // the slot pages are square, so the UV extent has the aspect ratio of the thumbnail
+    float width = image->Uv1.x - image->Uv0.x;
+    float height = image->Uv1.y - image->Uv0.y;
+    float scale = size / std::max(width, height);
+    ImVec2 p0(pos.x + (size - width * scale) * 0.5f, pos.y + (size - height * scale) * 0.5f);
+    ImVec2 p1(p0.x + width * scale, p0.y + height * scale);
+
+    drawList->AddImage((ImTextureID)&ThumbnailPages[image->Slot / ThumbnailsPerPage], p0, p1, image->Uv0, image->Uv1);
 }
 
-void rlImGuiImageSizeV(const Texture* image, Vector2 size)
+static AsyncImage* FindPackedImage(const Texture* texture)
 {
-    if (!image)
-        return;
-    
-    if (GlobalContext)
-        ImGui::SetCurrentContext(GlobalContext);
-    
-    ImGui::Image((ImTextureID)image, ImVec2(size.x, size.y));
+    return (AsyncImage*)PackedImageIndex.GetVoidPtr(texture->id);
 }
 
-void rlImGuiImageRect(const Texture* image, int destWidth, int destHeight, Rectangle sourceRect)
+// the copy of a small texture in the thumbnail pages, queued for copying on the render thread the first time it is drawn
+static AsyncImage* GetPackedImage(const Texture* texture)
 {
-    if (!image)
-        return;
-    
-    if (GlobalContext)
-        ImGui::SetCurrentContext(GlobalContext);
-    
-    ImVec2 uv0;
-    ImVec2 uv1;
-
-    if (sourceRect.width < 0)
+    AsyncImage* image = FindPackedImage(texture);
+    if (image == nullptr)
     {
-        uv0.x = -((float)sourceRect.x / image->width);
-        uv1.x = (uv0.x - (float)(fabs(sourceRect.width) / image->width));
+        image = IM_NEW(AsyncImage)();
+        image->Thumbnail = true;
+        image->Source = *texture;
+        image->State = AsyncImageState::Evicted;
+
+        AsyncImages.push_back(image);
+        PackedImageIndex.SetVoidPtr(texture->id, image);
     }
-    else
+    else if (image->Source.width != texture->width || image->Source.height != texture->height || image->Source.format != texture->format)
     {
-        uv0.x = (float)sourceRect.x / image->width;
-        uv1.x = uv0.x + (float)(sourceRect.width / image->width);
+        // reloaded into the same id, the copy is stale
+        rlImGuiReleasePackedImage(texture);
+        image->Source = *texture;
     }
 
-    if (sourceRect.height < 0)
-    {
-        uv0.y = -((float)sourceRect.y / image->height);
-        uv1.y = (uv0.y - (float)(fabs(sourceRect.height) / image->height));
-    }
-    else
+    image->LastUsedFrame = ImGui::GetFrameCount();
+    if (image->State == AsyncImageState::Evicted)
     {
-        uv0.y = (float)sourceRect.y / image->height;
-        uv1.y = uv0.y + (float)(sourceRect.height / image->height);
+        // nothing to decode, it goes straight to the uploads, which also run without workers
+        std::lock_guard<std::mutex> lock(ImageJobLock);
+        image->State = AsyncImageState::Decoded;
+        DecodedImages.push_back(image);
     }
 
-    ImGui::Image((ImTextureID)image, ImVec2(float(destWidth), float(destHeight)), uv0, uv1);
+    return image;
 }
 
-void rlImGuiImageRenderTexture(const RenderTexture* image)
+void rlImGuiImagePacked(const Texture* image, Vector2 size)
 {
     if (!image)
         return;
-    
+
     if (GlobalContext)
         ImGui::SetCurrentContext(GlobalContext);
-    
-    rlImGuiImageRect(&image->texture, image->texture.width, image->texture.height, Rectangle{ 0,0, float(image->texture.width), -float(image->texture.height) });
+
+    ImVec2 itemSize(size.x > 0 ? size.x : float(image->width), size.y > 0 ? size.y : float(image->height));
+
+    // larger textures would not fit a slot and compressed ones can not be copied, they are drawn on their own
+    // like rlImGuiImage, as is every texture where the copy into the pages is not available
+    AsyncImage* packed = nullptr;
+#ifdef RLIMGUI_GPU_PACKING
+    constexpr int fit = RLIMGUI_THUMBNAIL_SIZE - 2;
+    if (image->id != 0 && image->width <= fit && image->height <= fit && image->format < PIXELFORMAT_COMPRESSED_DXT1_RGB
+        && ImGui::IsRectVisible(itemSize))
+        packed = GetPackedImage(image);
+#endif
+
+    if (packed == nullptr || packed->State != AsyncImageState::Ready)
+    {
+        ImGui::Image((ImTextureID)image, itemSize);
+        return;
+    }
+
+    ImGui::Image((ImTextureID)&ThumbnailPages[packed->Slot / ThumbnailsPerPage], itemSize, packed->Uv0, packed->Uv1);
 }
 
-void rlImGuiImageRenderTextureFit(const RenderTexture* image, bool center)
+void rlImGuiReleasePackedImage(const Texture* image)
 {
     if (!image)
         return;
-    
-    if (GlobalContext)
-        ImGui::SetCurrentContext(GlobalContext);
 
-    ImVec2 area = ImGui::GetContentRegionAvail();
+    AsyncImage* packed = FindPackedImage(image);
+    if (packed == nullptr)
+        return;
 
-    float scale =  area.x / image->texture.width;
+    {
+        std::lock_guard<std::mutex> lock(ImageJobLock);
+        DecodedImages.find_erase(packed);
+    }
 
-    float y = image->texture.height * scale;
-    if (y > area.y)
+    // the slot is only given to another image once the frames that drew from it are rendered
+    if (packed->Slot >= 0)
     {
-        scale = area.y / image->texture.height;
+        ThumbnailSlots[packed->Slot] = nullptr;
+        ThumbnailSlotLastUsed[packed->Slot] = packed->LastUsedFrame;
     }
+    packed->Slot = -1;
+    packed->State = AsyncImageState::Evicted;
+}
 
-    int sizeX = int(image->texture.width * scale);
-    int sizeY = int(image->texture.height * scale);
+int rlImGuiThumbnailGrid(const char* name, const char** fileNames, int count, float thumbnailSize, int* selected)
+{
+    if (name == nullptr || fileNames == nullptr)
+        return -1;
 
-    if (center)
+    if (GlobalContext)
+        ImGui::SetCurrentContext(GlobalContext);
+
+    if (thumbnailSize <= 0)
+        thumbnailSize = float(RLIMGUI_THUMBNAIL_SIZE);
+
+    int clicked = -1;
+    if (ImGui::BeginChild(name))
     {
-        ImGui::SetCursorPosX(0);
-        ImGui::SetCursorPosX(area.x/2 - sizeX/2);
-        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + (area.y / 2 - sizeY / 2));
+        const ImGuiStyle& style = ImGui::GetStyle();
+        float available = ImGui::GetContentRegionAvail().x;
+        int columns = std::max(1, int((available + style.ItemSpacing.x) / (thumbnailSize + style.ItemSpacing.x)));
+        int rows = (count + columns - 1) / columns;
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        ImU32 selectedColor = ImGui::GetColorU32(ImGuiCol_ButtonActive);
+        ImU32 hoveredColor = ImGui::GetColorU32(ImGuiCol_ButtonHovered);
+
+        // only the rows in view are laid out, and only their thumbnails are loaded
+        ImGuiListClipper clipper;
+        clipper.Begin(rows, thumbnailSize + style.ItemSpacing.y);
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                for (int column = 0; column < columns; column++)
+                {
+                    int index = row * columns + column;
+                    if (index >= count)
+                        break;
+
+                    if (column > 0)
+                        ImGui::SameLine();
+
+                    ImGui::PushID(index);
+                    ImVec2 pos = ImGui::GetCursorScreenPos();
+                    if (ImGui::InvisibleButton("##thumbnail", ImVec2(thumbnailSize, thumbnailSize)))
+                    {
+                        clicked = index;
+                        if (selected != nullptr)
+                            *selected = index;
+                    }
+
+                    DrawThumbnail(drawList, fileNames[index], pos, thumbnailSize);
+
+                    ImVec2 end(pos.x + thumbnailSize, pos.y + thumbnailSize);
+                    if (selected != nullptr && *selected == index)
+                        drawList->AddRect(pos, end, selectedColor, 0, 0, 2);
+                    else if (ImGui::IsItemHovered())
+                        drawList->AddRect(pos, end, hoveredColor);
+
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("%s", GetFileName(fileNames[index]));
+                    ImGui::PopID();
+                }
+            }
+        }
     }
+    ImGui::EndChild();
 
-    rlImGuiImageRect(&image->texture, sizeX, sizeY, Rectangle{ 0,0, float(image->texture.width), -float(image->texture.height) });
+    return clicked;
 }
 
 // raw ImGui backend API
@@ -650,58 +4950,68 @@ void ImGui_ImplRaylib_BuildFontAtlas(void)
 
 void ImGui_ImplRaylib_Shutdown()
 {
+#ifdef RLIMGUI_DYNAMIC_TEXTURES
+    // textures still referenced elsewhere belong to a shared atlas, its owner destroys them
+    for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+    {
+        if (tex->RefCount == 1)
+            DestroyTexture(tex);
+    }
+#else
     ImGuiIO& io =ImGui::GetIO();
-    Texture2D* fontTexture = (Texture2D*)io.Fonts->TexID;
 
-    if (fontTexture)
+    if (FontTexture)
     {
-        UnloadTexture(*fontTexture);
-        MemFree(fontTexture);
+        UnloadTexture(*FontTexture);
+        MemFree(FontTexture);
+        FontTexture = nullptr;
     }
 
     io.Fonts->TexID = 0;
+    FontPixels.clear();
+#endif
+
+#ifdef RLIMGUI_RETAINED_RENDERER
+    UnloadGPUBuffers();
+#endif
+
+    UnloadCachedLayer();
+    UnloadSnapshots();
+    UnloadTileCache();
+    UnloadAsyncImages();
+    UnloadRenderTargetPool();
+
+#ifdef RLIMGUI_SDF_FONTS
+    UnloadSDFShader();
+#endif
+#ifdef RLIMGUI_ALPHA8_FONT_ATLAS
+    UnloadAlpha8Shader();
+#endif
 }
 
 void ImGui_ImplRaylib_NewFrame(void)
 {
+    UploadDecodedImages();
+
+#ifdef RLIMGUI_LAZY_ICONS
+    UpdateLazyIcons();
+#endif
+
     ImGuiNewFrame(GetFrameTime());
 }
 
 void ImGui_ImplRaylib_RenderDrawData(ImDrawData* draw_data)
 {
-    rlDrawRenderBatchActive();
-    rlDisableBackfaceCulling();
-
-    for (int l = 0; l < draw_data->CmdListsCount; ++l)
-    {
-        const ImDrawList* commandList = draw_data->CmdLists[l];
-
-        for (const auto& cmd : commandList->CmdBuffer)
-        {
-            EnableScissor(cmd.ClipRect.x - draw_data->DisplayPos.x, cmd.ClipRect.y - draw_data->DisplayPos.y, cmd.ClipRect.z - (cmd.ClipRect.x - draw_data->DisplayPos.x), cmd.ClipRect.w - (cmd.ClipRect.y - draw_data->DisplayPos.y));
-            if (cmd.UserCallback != nullptr)
-            {
-                cmd.UserCallback(commandList, &cmd);
-
-                continue;
-            }
-
-            ImGuiRenderTriangles(cmd.ElemCount, cmd.IdxOffset, commandList->IdxBuffer, commandList->VtxBuffer, (Texture2D*)cmd.TextureId);
-            rlDrawRenderBatchActive();
-        }
-    }
-
-    rlSetTexture(0);
-    rlDisableScissorTest();
-    rlEnableBackfaceCulling();
+    SubmitDrawData(draw_data, GetFramebufferScale(draw_data));
+    RecordRenderStats();
 }
 
 void HandleGamepadButtonEvent(ImGuiIO& io, GamepadButton button, ImGuiKey key)
 {
     if (IsGamepadButtonPressed(0, button))
-        io.AddKeyEvent(key, true);
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::Key, key, true));
     else if (IsGamepadButtonReleased(0, button))
-        io.AddKeyEvent(key, false);
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::Key, key, false));
 }
 
 void HandleGamepadStickEvent(ImGuiIO& io, GamepadAxis axis, ImGuiKey negKey, ImGuiKey posKey)
@@ -710,48 +5020,63 @@ void HandleGamepadStickEvent(ImGuiIO& io, GamepadAxis axis, ImGuiKey negKey, ImG
 
     float axisValue = GetGamepadAxisMovement(0, axis);
 
-    io.AddKeyAnalogEvent(negKey, axisValue < -deadZone, axisValue < -deadZone ? -axisValue : 0);
-    io.AddKeyAnalogEvent(posKey, axisValue > deadZone, axisValue > deadZone ? axisValue : 0);
+    SubmitInputEvent(io, MakeInputEvent(InputEventType::KeyAnalog, negKey, axisValue < -deadZone, axisValue < -deadZone ? -axisValue : 0));
+    SubmitInputEvent(io, MakeInputEvent(InputEventType::KeyAnalog, posKey, axisValue > deadZone, axisValue > deadZone ? axisValue : 0));
 }
 
-bool ImGui_ImplRaylib_ProcessEvents(void)
+static bool ProcessInputEvents(void)
 {
     ImGuiIO& io = ImGui::GetIO();
 
+#ifdef RLIMGUI_GLFW_INPUT
+    InstallInputCallbacks();
+#endif
+
+    if (Replaying)
+    {
+#ifdef RLIMGUI_GLFW_INPUT
+        MouseEventQueue.clear();
+        ForwardedMouseMoves.clear();
+#endif
+        ReplayInputEvents(io);
+        return true;
+    }
+
+    if (InputResetPending)
+    {
+        ResetInputState();
+        InputResetPending = false;
+    }
+
     bool focused = IsWindowFocused();
     if (focused != LastFrameFocused)
-        io.AddFocusEvent(focused);
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::Focus, 0, focused));
     LastFrameFocused = focused;
 
     // handle the modifyer key events so that shortcuts work
     bool ctrlDown = rlImGuiIsControlDown();
     if (ctrlDown != LastControlPressed)
-        io.AddKeyEvent(ImGuiMod_Ctrl, ctrlDown);
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::Key, ImGuiMod_Ctrl, ctrlDown));
     LastControlPressed = ctrlDown;
 
     bool shiftDown = rlImGuiIsShiftDown();
     if (shiftDown != LastShiftPressed)
-        io.AddKeyEvent(ImGuiMod_Shift, shiftDown);
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::Key, ImGuiMod_Shift, shiftDown));
     LastShiftPressed = shiftDown;
 
     bool altDown = rlImGuiIsAltDown();
     if (altDown != LastAltPressed)
-        io.AddKeyEvent(ImGuiMod_Alt, altDown);
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::Key, ImGuiMod_Alt, altDown));
     LastAltPressed = altDown;
 
     bool superDown = rlImGuiIsSuperDown();
     if (superDown != LastSuperPressed)
-        io.AddKeyEvent(ImGuiMod_Super, superDown);
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::Key, ImGuiMod_Super, superDown));
     LastSuperPressed = superDown;
 
-    // walk the keymap and check for up and down events
-    for (const auto keyItr : RaylibKeyMap)
-    {
-        if (IsKeyReleased(keyItr.first))
-            io.AddKeyEvent(keyItr.second, false);
-        else if(IsKeyPressed(keyItr.first))
-            io.AddKeyEvent(keyItr.second, true);
-    }
+    // while ImGui has the keyboard the key queue is consumed, like the text input below, so only the keys
+    // raylib reports as pressed are translated. Otherwise every mapped key is polled and the queue is left to the app
+    rlImGuiKeymap::TranslateKeyEvents<RaylibKeyboard>(HeldKeys, io.WantCaptureKeyboard, [&io](ImGuiKey key, bool down) { SubmitInputEvent(io, MakeInputEvent(InputEventType::Key, key, down)); });
 
     if (io.WantCaptureKeyboard)
     {
@@ -759,33 +5084,43 @@ bool ImGui_ImplRaylib_ProcessEvents(void)
         unsigned int pressed = GetCharPressed();
         while (pressed != 0)
         {
-            io.AddInputCharacter(pressed);
+            SubmitInputEvent(io, MakeInputEvent(InputEventType::Char, pressed, false));
             pressed = GetCharPressed();
         }
     }
 
+    bool mouseQueued = false;
+#ifdef RLIMGUI_GLFW_INPUT
+    mouseQueued = ForwardMouseEventQueue(io);
+#endif
+
+    // after the queued moves this only adds the low latency position, ImGui drops it when it did not change
     if (!io.WantSetMousePos)
     {
-        io.AddMousePosEvent((float)GetMouseX(), (float)GetMouseY());
+        Vector2 mousePosition = GetSampledMousePosition();
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::MousePos, 0, false, mousePosition.x, mousePosition.y));
     }
 
-    auto setMouseEvent = [&io](int rayMouse, int imGuiMouse)
-        {
-            if (IsMouseButtonPressed(rayMouse))
-                io.AddMouseButtonEvent(imGuiMouse, true);
-            else if (IsMouseButtonReleased(rayMouse))
-                io.AddMouseButtonEvent(imGuiMouse, false);
-        };
-
-    setMouseEvent(MOUSE_BUTTON_LEFT, ImGuiMouseButton_Left);
-    setMouseEvent(MOUSE_BUTTON_RIGHT, ImGuiMouseButton_Right);
-    setMouseEvent(MOUSE_BUTTON_MIDDLE, ImGuiMouseButton_Middle);
-    setMouseEvent(MOUSE_BUTTON_FORWARD, ImGuiMouseButton_Middle + 1);
-    setMouseEvent(MOUSE_BUTTON_BACK, ImGuiMouseButton_Middle + 2);
+    if (!mouseQueued)
+    {
+        auto setMouseEvent = [&io](int rayMouse, int imGuiMouse)
+            {
+                if (IsMouseButtonPressed(rayMouse))
+                    SubmitInputEvent(io, MakeInputEvent(InputEventType::MouseButton, imGuiMouse, true));
+                else if (IsMouseButtonReleased(rayMouse))
+                    SubmitInputEvent(io, MakeInputEvent(InputEventType::MouseButton, imGuiMouse, false));
+            };
+
+        setMouseEvent(MOUSE_BUTTON_LEFT, ImGuiMouseButton_Left);
+        setMouseEvent(MOUSE_BUTTON_RIGHT, ImGuiMouseButton_Right);
+        setMouseEvent(MOUSE_BUTTON_MIDDLE, ImGuiMouseButton_Middle);
+        setMouseEvent(MOUSE_BUTTON_FORWARD, ImGuiMouseButton_Middle + 1);
+        setMouseEvent(MOUSE_BUTTON_BACK, ImGuiMouseButton_Middle + 2);
+    }
 
     {
         Vector2 mouseWheel = GetMouseWheelMoveV();
-        io.AddMouseWheelEvent(mouseWheel.x, mouseWheel.y);
+        SubmitInputEvent(io, MakeInputEvent(InputEventType::MouseWheel, 0, false, mouseWheel.x, mouseWheel.y));
     }
 
     if (io.ConfigFlags & ImGuiConfigFlags_NavEnableGamepad && IsGamepadAvailable(0))
@@ -821,3 +5156,12 @@ bool ImGui_ImplRaylib_ProcessEvents(void)
 
     return true;
 }
+
+bool ImGui_ImplRaylib_ProcessEvents(void)
+{
+    double start = GetTime();
+    SampleInputTime(start);
+    bool handled = ProcessInputEvents();
+    ProcessEventsTime = float((GetTime() - start) * 1000.0);
+    return handled;
+}
@@ -61,10 +61,81 @@
 #endif
 #endif
 
+// number of frames of render statistics kept for rlImGuiGetRenderStatsHistory
+#ifndef RLIMGUI_STATS_HISTORY
+#define RLIMGUI_STATS_HISTORY 240
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/// <summary>
+/// Statistics about one frame submitted by rlImGui
+/// </summary>
+typedef struct rlImGuiRenderStats
+{
+    int drawLists;          // ImDrawLists in the submitted draw data
+    int drawCommands;       // ImDrawCmds in the submitted draw data
+    int mergedCommands;     // commands folded into the previous draw because texture, clip rect and vertex offset matched
+    int vertices;           // ImDrawVerts in the submitted draw data
+    int indices;            // ImDrawIdx in the submitted draw data
+    int batchFlushes;       // draws actually sent to the GPU
+    int flushesSaved;       // flushes avoided compared to flushing after every command
+    int culledCommands;     // commands skipped because they had no geometry or their clip rect was empty or off screen
+    int scissorChanges;     // scissor rects sent to GL
+    int scissorsSkipped;    // scissor updates skipped because the rect was already set
+    int textureSwitches;    // texture binds
+    int texturesSkipped;    // texture binds skipped because the texture was already bound
+    float renderTime;       // milliseconds of CPU time spent submitting the draw data (ImGui_ImplRaylib_RenderDrawData)
+    float processEventsTime; // milliseconds of CPU time spent in ImGui_ImplRaylib_ProcessEvents for this frame
+    int idleFramesSkipped;  // frames skipped with rlImGuiSkipFrame right before this one
+    int totalFramesSkipped; // frames skipped with rlImGuiSkipFrame since startup
+    int cachedLayerReuses;  // frames composited from the cached UI layer without submitting ImGui geometry, since startup
+    int rawInputEvents;     // input events raylib received since the previous frame read input, GLFW desktop builds only
+    float inputToSample;    // milliseconds from the oldest of those events to ImGui_ImplRaylib_ProcessEvents reading input
+    float inputToProcess;   // milliseconds from that event to ImGui::NewFrame applying it (rlImGuiBegin only)
+    float inputToSubmit;    // milliseconds from that event to the end of the draw data submission
+    float inputToPresent;   // milliseconds from that event to rlImGuiMarkPresent, 0 if it was not called for this frame
+} rlImGuiRenderStats;
+
+/// <summary>
+/// Percentiles of one latency over the kept frame history, in milliseconds
+/// </summary>
+typedef struct rlImGuiLatency
+{
+    float p50;
+    float p90;
+    float p99;
+    float max;
+} rlImGuiLatency;
+
+/// <summary>
+/// Input latency distributions over the kept frame history.
+/// Without raw input timestamps (builds not using GLFW) every frame counts, measured from when input was read.
+/// </summary>
+typedef struct rlImGuiLatencyStats
+{
+    int frames;                     // frames that received input
+    int presentedFrames;            // those of them marked with rlImGuiMarkPresent
+    rlImGuiLatency inputToSample;
+    rlImGuiLatency inputToSubmit;
+    rlImGuiLatency inputToPresent;
+} rlImGuiLatencyStats;
+
+/// <summary>
+/// Counters of the render target pool, since startup
+/// </summary>
+typedef struct rlImGuiRenderTargetStats
+{
+    int targets;            // render textures held by the pool, in use or waiting for reuse
+    int inUse;              // of them, acquired and not released
+    int acquires;           // calls to rlImGuiAcquireRenderTarget, including those from rlImGuiResizeRenderTarget
+    int reuses;             // acquires served by a released target instead of a new allocation
+    int allocations;        // render textures created
+    long long bytesHeld;    // approximate GPU memory of the held targets, color and depth
+} rlImGuiRenderTargetStats;
+
 // High level API. This API is designed in the style of raylib and meant to work with reaylib code.
 // It will manage it's own ImGui context and call common ImGui functions (like NewFrame and Render) for you
 // for a lower level API that matches the other ImGui platforms, please see imgui_impl_raylib.h
@@ -85,9 +156,19 @@ RLIMGUIAPI void rlImGuiBegin(void);
 /// <summary>
 /// Ends an ImGui frame and submits all ImGui drawing to raylib for processing.
 /// Calls ImGui:Render, an d ImGui_ImplRaylib_RenderDrawData to draw to the current raylib render target
+/// If the frame was already finished with rlImGuiPrepareFrame it is only submitted.
 /// </summary>
 RLIMGUIAPI void rlImGuiEnd(void);
 
+/// <summary>
+/// Sets the shader ImGui is drawn with, for an app that draws the UI inside BeginShaderMode.
+/// rlgl has no way to read the shader BeginShaderMode made current, and the retained renderer and the special
+/// font atlas modes pick a shader themselves, so they need it passed here. It is made current again after ImGui drew.
+/// The shader must use raylib's default vertex attributes and uniforms.
+/// </summary>
+/// <param name="shader">The shader, one with id 0 for raylib's default shader</param>
+RLIMGUIAPI void rlImGuiSetShader(Shader shader);
+
 /// <summary>
 /// Cleanup ImGui and unload font atlas
 /// Calls ImGui_ImplRaylib_Shutdown
@@ -110,11 +191,100 @@ RLIMGUIAPI void rlImGuiBeginInitImGui(void);
 /// </summary>
 RLIMGUIAPI void rlImGuiEndInitImGui(void);
 
+/// <summary>
+/// Starts setup with the font atlas built (decompressed, rasterized and packed) on a worker thread.
+/// Can be called before InitWindow, so the build overlaps window and GL context creation. Before the window exists
+/// the DPI scale is taken as 1, and the fonts are baked again in rlImGuiEndSetupAsync if the window differs.
+/// Do not call other ImGui or rlImGui functions until rlImGuiEndSetupAsync.
+/// </summary>
+/// <param name="darkTheme">when true the dark theme is used, when false the light theme is used</param>
+RLIMGUIAPI void rlImGuiBeginSetupAsync(bool darkTheme);
+
+/// <summary>
+/// Polls the font atlas build started by rlImGuiBeginSetupAsync.
+/// </summary>
+/// <returns>True when rlImGuiEndSetupAsync will not have to wait for the build</returns>
+RLIMGUIAPI bool rlImGuiIsSetupReady(void);
+
+/// <summary>
+/// Waits for the font atlas build started by rlImGuiBeginSetupAsync, then finishes setup and uploads the atlas.
+/// Must be called on the thread that owns the window, after InitWindow. rlImGuiBegin calls it if needed.
+/// </summary>
+RLIMGUIAPI void rlImGuiEndSetupAsync(void);
+
 /// <summary>
 /// Forces the font texture atlas to be recomputed and re-cached
 /// </summary>
 RLIMGUIAPI void rlImGuiReloadFonts(void);
 
+/// <summary>
+/// Gets the renderer statistics of the last submitted frame
+/// </summary>
+/// <returns>Geometry counts, GL state changes and CPU timings of the last frame, all zero before the first frame</returns>
+RLIMGUIAPI rlImGuiRenderStats rlImGuiGetRenderStats(void);
+
+/// <summary>
+/// Copies the statistics of the last frames, up to RLIMGUI_STATS_HISTORY of them are kept
+/// </summary>
+/// <param name="stats">array that receives the frames, oldest first</param>
+/// <param name="maxCount">size of the array, the newest maxCount frames are copied</param>
+/// <returns>The number of frames copied</returns>
+RLIMGUIAPI int rlImGuiGetRenderStatsHistory(rlImGuiRenderStats* stats, int maxCount);
+
+/// <summary>
+/// Writes the kept frame statistics to a CSV file, one row per frame, oldest first
+/// </summary>
+/// <param name="fileName">path of the file to write</param>
+/// <returns>True if the file was written</returns>
+RLIMGUIAPI bool rlImGuiExportRenderStats(const char* fileName);
+
+/// <summary>
+/// Marks the frame submitted by the last rlImGuiEnd as presented, completing its input to present latency.
+/// Call right after EndDrawing (or after SwapScreenBuffer with SUPPORT_CUSTOM_FRAME_CONTROL).
+/// EndDrawing also waits for the SetTargetFPS frame time after the buffer swap, that wait is included.
+/// </summary>
+RLIMGUIAPI void rlImGuiMarkPresent(void);
+
+/// <summary>
+/// Gets the distributions of the input latencies in the kept frame history
+/// </summary>
+/// <returns>Percentiles from input arrival to sampling, submission and present</returns>
+RLIMGUIAPI rlImGuiLatencyStats rlImGuiGetLatencyStats(void);
+
+/// <summary>
+/// In low latency mode the mouse position ImGui gets is read from the OS when rlImGui reads input,
+/// instead of the position raylib polled at the end of the previous frame, before any scene update and drawing.
+/// Only on GLFW desktop builds, and only while SetMouseOffset and SetMouseScale are not used. Disabled by default.
+/// </summary>
+/// <param name="enabled">True to read the mouse position as late as possible</param>
+RLIMGUIAPI void rlImGuiSetLowLatency(bool enabled);
+
+/// <summary>
+/// Forwards every cursor move and mouse button transition raylib received since the last frame to ImGui, in order,
+/// instead of one position and button state per frame. Strokes keep their shape and short clicks are not lost
+/// at low frame rates, or across frames skipped with rlImGuiSkipFrame. Only on GLFW desktop builds. Enabled by default.
+/// </summary>
+/// <param name="enabled">True to queue mouse events, false to poll the mouse state once per frame</param>
+RLIMGUIAPI void rlImGuiSetMouseEventQueue(bool enabled);
+
+/// <summary>
+/// Copies the cursor moves the mouse event queue forwarded to ImGui this frame, oldest first, with the GetTime each one
+/// arrived at. ImGui's input queue has no timestamps, so strokes that need the speed of the mouse read them here.
+/// Replays and the recording format do not keep the times. Returns 0 when the queue is not in use.
+/// </summary>
+/// <param name="positions">Receives the positions, may be NULL</param>
+/// <param name="times">Receives the arrival times in GetTime seconds, may be NULL</param>
+/// <param name="maxCount">Size of the arrays</param>
+/// <returns>The number of moves copied</returns>
+RLIMGUIAPI int rlImGuiGetMouseMoves(Vector2* positions, double* times, int maxCount);
+
+/// <summary>
+/// Shows a window with the current render statistics and plots of their history.
+/// Call between rlImGuiBegin and rlImGuiEnd
+/// </summary>
+/// <param name="open">optional, set to false when the window is closed</param>
+RLIMGUIAPI void rlImGuiShowRenderStats(bool* open);
+
 // Advanced Update API
 
 /// <summary>
@@ -123,6 +293,163 @@ RLIMGUIAPI void rlImGuiReloadFonts(void);
 /// <param name="dt">delta time, any value < 0 will use raylib GetFrameTime</param>
 RLIMGUIAPI void rlImGuiBeginDelta(float deltaTime);
 
+// Idle frame API
+// Lets applications stop drawing and presenting while the UI does not change.
+// Build the UI outside of BeginDrawing/EndDrawing, then:
+//
+//  if (rlImGuiPrepareFrame() || sceneChanged)
+//  {
+//      BeginDrawing();
+//      ... draw the scene ...
+//      rlImGuiEnd();
+//      EndDrawing();
+//  }
+//  else
+//  {
+//      rlImGuiSkipFrame();
+//  }
+
+/// <summary>
+/// Finishes the current ImGui frame (calls ImGui::Render) and hashes its draw data without submitting it.
+/// Must be followed by either rlImGuiEnd or rlImGuiSkipFrame
+/// Only ImGui geometry is compared, textures whose contents change (like render textures) are not,
+/// call rlImGuiInvalidateFrame when one of them changed.
+/// </summary>
+/// <returns>True if the frame differs from the last frame submitted with rlImGuiEnd, or was invalidated</returns>
+RLIMGUIAPI bool rlImGuiPrepareFrame(void);
+
+/// <summary>
+/// Makes the next rlImGuiPrepareFrame return true, and redraws the cached UI layer, even if the UI did not change.
+/// Call it when the contents of a texture shown by ImGui changed, like a render texture or an UpdateTexture target.
+/// </summary>
+RLIMGUIAPI void rlImGuiInvalidateFrame(void);
+
+/// <summary>
+/// Skips a prepared frame that did not change, the last presented frame stays on screen.
+/// Replaces BeginDrawing/EndDrawing for this frame, waits for the rest of a 1 / RLIMGUI_IDLE_FPS frame time
+/// since rlImGuiBegin and polls input events.
+/// </summary>
+RLIMGUIAPI void rlImGuiSkipFrame(void);
+
+// Snapshot API
+// Decouples building the UI from submitting it to the GPU. rlImGuiEndSnapshot finishes the ImGui frame and
+// copies its draw data into one of two buffers, rlImGuiDrawSnapshot draws the latest copy.
+// raylib's GL context belongs to the thread that called InitWindow, and rlImGuiBegin reads raylib input,
+// so both rlImGuiBegin and rlImGuiDrawSnapshot stay on that thread. The widget code and rlImGuiEndSnapshot
+// may run on a worker thread, so the main thread can submit frame N while the worker builds frame N+1:
+//
+//  main thread                     worker thread
+//  rlImGuiBegin();         ---->   ... build the UI ...
+//  BeginDrawing();                 rlImGuiEndSnapshot();
+//  ... draw the scene ...
+//  rlImGuiDrawSnapshot();
+//  EndDrawing();           <----   (wait for the worker before the next rlImGuiBegin)
+//
+// User callbacks in the draw lists run on the thread calling rlImGuiDrawSnapshot.
+
+/// <summary>
+/// Ends an ImGui frame like rlImGuiEnd, but copies the draw data into a snapshot instead of drawing it.
+/// May be called from a thread other than the one that owns the raylib window.
+/// </summary>
+RLIMGUIAPI void rlImGuiEndSnapshot(void);
+
+/// <summary>
+/// Draws the latest snapshot made with rlImGuiEndSnapshot. Call between BeginDrawing and EndDrawing on the window thread.
+/// </summary>
+/// <returns>False if no snapshot was made yet</returns>
+RLIMGUIAPI bool rlImGuiDrawSnapshot(void);
+
+// Lazy icon API
+
+/// <summary>
+/// When enabled only the Font Awesome icons registered with rlImGuiAddIcons or rlImGuiIcons are rasterized,
+/// instead of the whole icon range. The atlas is rebuilt at the start of the next frame when new icons are registered.
+/// Call before rlImGuiSetup. With rlImGuiEndSnapshot the atlas is not rebuilt, so register every icon before setup.
+/// ImGui 1.92 and later always rasterize glyphs on first use, so this has no effect there.
+/// </summary>
+/// <param name="enabled">True to rasterize only used icons</param>
+RLIMGUIAPI void rlImGuiSetLazyIcons(bool enabled);
+
+/// <summary>
+/// Registers the icons in a UTF-8 string, like ICON_FA_FLOPPY_DISK ICON_FA_FOLDER_OPEN, for lazy icon mode.
+/// </summary>
+/// <param name="icons">Text containing icons, other characters are ignored</param>
+RLIMGUIAPI void rlImGuiAddIcons(const char* icons);
+
+/// <summary>
+/// Registers the icons in a label and returns the label, so icons can be registered on first use:
+/// ImGui::Button(rlImGuiIcons(ICON_FA_FLOPPY_DISK " Save")). A new icon shows as the fallback glyph for one frame.
+/// </summary>
+/// <param name="text">Text containing icons</param>
+/// <returns>The same text</returns>
+RLIMGUIAPI const char* rlImGuiIcons(const char* text);
+
+// Font cache API
+
+/// <summary>
+/// Caches the baked font atlas in a file, so later launches with the same fonts skip rasterizing and packing them.
+/// The file is keyed by the font configs, atlas settings and DPI scale, and is rewritten when any of them change.
+/// Call before rlImGuiSetup (or before rlImGuiReloadFonts after adding fonts). Has no effect with ImGui 1.92 or later,
+/// which rasterizes glyphs on demand.
+/// </summary>
+/// <param name="fileName">The cache file path, NULL to disable the cache</param>
+RLIMGUIAPI void rlImGuiSetFontCache(const char* fileName);
+
+// Input recording API
+// Records every input event rlImGui feeds to ImGui (keys, text, mouse, focus and gamepad), with the frame time and
+// display size of each frame, to a binary file. A replay feeds the recorded events instead of reading raylib input,
+// and runs each frame with its recorded frame time whatever delta is passed to rlImGuiBeginDelta.
+// Replaying from right after setup, with the same UI code and fonts, reproduces the recorded session frame for frame.
+
+/// <summary>
+/// Starts recording input, from the next frame on
+/// </summary>
+/// <param name="fileName">The file rlImGuiStopRecording writes the session to</param>
+/// <returns>True if recording started</returns>
+RLIMGUIAPI bool rlImGuiStartRecording(const char* fileName);
+
+/// <summary>
+/// Stops recording input and writes the recorded frames. rlImGuiShutdown calls it if needed.
+/// </summary>
+/// <returns>True if the file was written</returns>
+RLIMGUIAPI bool rlImGuiStopRecording(void);
+
+/// <summary>
+/// Starts replaying a recorded session from the next frame on. Input held down in ImGui is released first.
+/// Live input resumes once the last recorded frame was replayed.
+/// </summary>
+/// <param name="fileName">A file written by rlImGuiStopRecording</param>
+/// <returns>True if the file was loaded</returns>
+RLIMGUIAPI bool rlImGuiStartReplay(const char* fileName);
+
+/// <summary>
+/// Stops a replay before its end and goes back to live input
+/// </summary>
+RLIMGUIAPI void rlImGuiStopReplay(void);
+
+/// <summary>
+/// Checks if a replay is running
+/// </summary>
+/// <returns>True until the last recorded frame was replayed</returns>
+RLIMGUIAPI bool rlImGuiIsReplaying(void);
+
+// Cached layer API
+
+/// <summary>
+/// When enabled rlImGuiEnd draws ImGui into an offscreen render texture only when the UI changed,
+/// and composites that texture over the current frame with a single quad. Disabled by default.
+/// Useful when the scene under the UI animates but the UI is mostly static.
+/// The layer is composited to the screen, so rlImGuiEnd must not be called inside BeginTextureMode.
+/// </summary>
+/// <param name="enabled">True to use the cached layer, false to draw ImGui directly every frame and free the layer</param>
+RLIMGUIAPI void rlImGuiSetCachedLayer(bool enabled);
+
+/// <summary>
+/// Forces the cached UI layer to be redrawn on the next rlImGuiEnd.
+/// Only ImGui geometry is compared, call this when a texture shown by ImGui (like a render texture) changed.
+/// </summary>
+RLIMGUIAPI void rlImGuiInvalidateCachedLayer(void);
+
 // ImGui Image API extensions
 // Purely for convenience in working with raylib textures as images.
 // If you want to call ImGui image functions directly, simply pass them the pointer to the texture.
@@ -195,6 +522,207 @@ bool rlImGuiImageButton(const char* name, const Texture* image);
 /// <returns>True if the button was clicked</returns>
 RLIMGUIAPI bool rlImGuiImageButtonSize(const char* name, const Texture* image, Vector2 size);
 
+// Render target pool API
+// Render textures for panels that show a rendered view, sized to the panel instead of the screen.
+// Sizes are rounded up to buckets, so a live resize mostly keeps its target, and released targets are reused
+// by later requests of the same bucket, from any panel. Only the requested corner of a target is drawn and shown.
+// All targets are unloaded by rlImGuiShutdown.
+
+/// <summary>
+/// Gets a render target at least width x height from the pool.
+/// </summary>
+/// <param name="width">The width needed</param>
+/// <param name="height">The height needed</param>
+/// <returns>The target, or NULL if it could not be created. It keeps its address until released.</returns>
+RLIMGUIAPI RenderTexture* rlImGuiAcquireRenderTarget(int width, int height);
+
+/// <summary>
+/// Returns a render target to the pool. It is unloaded if no request reuses it for a while.
+/// </summary>
+/// <param name="target">The target from rlImGuiAcquireRenderTarget, may be NULL</param>
+RLIMGUIAPI void rlImGuiReleaseRenderTarget(RenderTexture* target);
+
+/// <summary>
+/// Makes sure a render target holds width x height, keeping it when it already does in the same bucket,
+/// otherwise releasing it and acquiring one that does. Call it when the panel size changes.
+/// </summary>
+/// <param name="target">The current target, may be NULL</param>
+/// <param name="width">The width needed</param>
+/// <param name="height">The height needed</param>
+/// <returns>The target to use from now on</returns>
+RLIMGUIAPI RenderTexture* rlImGuiResizeRenderTarget(RenderTexture* target, int width, int height);
+
+/// <summary>
+/// Begins drawing to the width x height corner of a render target, like BeginTextureMode.
+/// 2D drawing and BeginMode2D use that size. raylib keeps the size of the whole texture for BeginMode3D and
+/// BeginScissorMode, which can not be changed from outside, so use rlImGuiBeginRenderTargetMode3D and
+/// rlImGuiBeginRenderTargetScissor instead. End with EndTextureMode.
+/// </summary>
+/// <param name="target">The target to draw to</param>
+/// <param name="width">The width of the drawn area</param>
+/// <param name="height">The height of the drawn area</param>
+RLIMGUIAPI void rlImGuiBeginRenderTarget(const RenderTexture* target, int width, int height);
+
+/// <summary>
+/// Begins 3D mode inside rlImGuiBeginRenderTarget, like BeginMode3D but with the aspect ratio of the drawn corner
+/// instead of the whole render target. End with EndMode3D.
+/// </summary>
+/// <param name="camera">The camera to draw with</param>
+RLIMGUIAPI void rlImGuiBeginRenderTargetMode3D(Camera3D camera);
+
+/// <summary>
+/// Begins scissor mode inside rlImGuiBeginRenderTarget, like BeginScissorMode but measured from the top of the
+/// drawn corner instead of the whole render target. End with EndScissorMode.
+/// </summary>
+/// <param name="x">The left of the scissor rectangle</param>
+/// <param name="y">The top of the scissor rectangle</param>
+/// <param name="width">The width of the scissor rectangle</param>
+/// <param name="height">The height of the scissor rectangle</param>
+RLIMGUIAPI void rlImGuiBeginRenderTargetScissor(int x, int y, int width, int height);
+
+/// <summary>
+/// Draws the width x height corner of a render target drawn with rlImGuiBeginRenderTarget, the right way up.
+/// </summary>
+/// <param name="target">The target to draw</param>
+/// <param name="width">The width of the drawn area</param>
+/// <param name="height">The height of the drawn area</param>
+RLIMGUIAPI void rlImGuiImageRenderTarget(const RenderTexture* target, int width, int height);
+
+/// <summary>
+/// Gets the render target pool counters
+/// </summary>
+RLIMGUIAPI rlImGuiRenderTargetStats rlImGuiGetRenderTargetStats(void);
+
+// Tiled image API
+// Shows images too large for one texture, or for GPU memory, from a pyramid of tile files on disk.
+// Level 0 is the full resolution image, every next level halves it (rounding up), down to a level that fits one tile.
+// Every level is cut into tileSize x tileSize tiles, smaller at the right and bottom edges, stored as image files
+// named by a printf pattern taking the level, column and row, like "tiles/%d/%d_%d.png".
+// Only the visible tiles of the level closest to the screen resolution are loaded, decoded on the rlImGuiImageAsync
+// workers and uploaded within its budget, into a tile cache of RLIMGUI_TILE_CACHE_SIZE textures shared by all tiled
+// images that evicts the least recently drawn tiles. Tiles still loading are covered with coarser levels.
+
+typedef struct rlImGuiTiledImage rlImGuiTiledImage;
+
+/// <summary>
+/// Describes a tiled image pyramid on disk, no tiles are loaded until the image is drawn
+/// </summary>
+/// <param name="tilePath">printf pattern of the tile files, taking the level, column and row</param>
+/// <param name="width">width of the full resolution image in pixels</param>
+/// <param name="height">height of the full resolution image in pixels</param>
+/// <param name="tileSize">width and height of the tiles</param>
+/// <param name="levels">number of levels, 0 to go down to the level that fits one tile</param>
+/// <returns>The tiled image, or NULL if the description is invalid</returns>
+RLIMGUIAPI rlImGuiTiledImage* rlImGuiLoadTiledImage(const char* tilePath, int width, int height, int tileSize, int levels);
+
+/// <summary>
+/// Frees a tiled image and its cached tiles. Tiles drawn by frames not rendered yet are kept until they are.
+/// </summary>
+RLIMGUIAPI void rlImGuiUnloadTiledImage(rlImGuiTiledImage* image);
+
+/// <summary>
+/// Writes an image as a tile pyramid that rlImGuiLoadTiledImage can read, creating the directories of the tiles.
+/// The image must fit in memory, use a tiling tool for larger ones.
+/// </summary>
+/// <param name="image">the full resolution image</param>
+/// <param name="tilePath">printf pattern of the tile files, taking the level, column and row</param>
+/// <param name="tileSize">width and height of the tiles</param>
+/// <returns>The number of levels written, 0 on failure</returns>
+RLIMGUIAPI int rlImGuiExportTiledImage(Image image, const char* tilePath, int tileSize);
+
+/// <summary>
+/// Draws part of a tiled image in an ImGui Context at a specific size, like rlImGuiImageRect
+/// </summary>
+/// <param name="image">The tiled image to draw</param>
+/// <param name="destWidth">The width of the drawn image</param>
+/// <param name="destHeight">The height of the drawn image</param>
+/// <param name="sourceRect">The part of the image to draw, in full resolution pixels</param>
+RLIMGUIAPI void rlImGuiTiledImageRect(const rlImGuiTiledImage* image, int destWidth, int destHeight, Rectangle sourceRect);
+
+/// <summary>
+/// Draws a tiled image in a pan and zoom view. Drag with the left or middle button to pan, use the wheel to zoom,
+/// double click to fit the whole image. The view is kept in the tiled image.
+/// </summary>
+/// <param name="name">The ImGui ID of the view</param>
+/// <param name="image">The tiled image to draw</param>
+/// <param name="size">The size of the view, 0 to fill the available content area</param>
+RLIMGUIAPI void rlImGuiTiledImageViewer(const char* name, rlImGuiTiledImage* image, Vector2 size);
+
+// Async image API
+// Image files are decoded on worker threads and uploaded to textures on the render thread, a few rows at a time
+// within a per frame time budget, so loading a folder of images does not stall the UI.
+// Images are kept by file name until rlImGuiUnloadImageAsync or rlImGuiShutdown. Unloaded and failed files are
+// forgotten once they were not drawn for RLIMGUI_IMAGE_IDLE_FRAMES frames, 600 by default.
+// Compressed images (DDS, KTX...) and images with mipmaps are uploaded whole.
+
+/// <summary>
+/// Draws an image from a file, loading it in the background the first time it is visible.
+/// A placeholder of the same size is drawn until the texture is ready.
+/// </summary>
+/// <param name="fileName">The image file to draw</param>
+/// <param name="size">The size of the image, 0 in one dimension to follow the aspect ratio, 0 in both for the image size</param>
+/// <returns>True if the image was drawn, false if the placeholder was</returns>
+RLIMGUIAPI bool rlImGuiImageAsync(const char* fileName, Vector2 size);
+
+/// <summary>
+/// Gets the texture of an image file, queuing it for loading the first time.
+/// </summary>
+/// <param name="fileName">The image file</param>
+/// <returns>The texture, or NULL while it is loading. It stays valid until the image is unloaded.</returns>
+RLIMGUIAPI const Texture* rlImGuiGetImageAsync(const char* fileName);
+
+/// <summary>
+/// Checks if an image file could not be loaded.
+/// </summary>
+/// <param name="fileName">The image file</param>
+/// <returns>True if the file could not be decoded</returns>
+RLIMGUIAPI bool rlImGuiIsImageAsyncFailed(const char* fileName);
+
+/// <summary>
+/// Releases the texture of an image file. Frames already drawn with it keep it until they are rendered.
+/// Drawing the image again loads it again.
+/// </summary>
+/// <param name="fileName">The image file</param>
+RLIMGUIAPI void rlImGuiUnloadImageAsync(const char* fileName);
+
+/// <summary>
+/// Sets how long texture uploads may take each frame. At least one strip of rows is uploaded every frame.
+/// </summary>
+/// <param name="milliseconds">The upload time per frame, 2 ms by default</param>
+RLIMGUIAPI void rlImGuiSetImageUploadBudget(float milliseconds);
+
+/// <summary>
+/// Draws a scrolling grid of image file thumbnails in a child window that fills the available content area.
+/// Thumbnails are loaded like rlImGuiImageAsync and scaled down into a few shared atlas pages, so the grid renders
+/// in a handful of draw calls. Only the visible rows are laid out and loaded, the least recently drawn thumbnails
+/// give up their atlas space when it runs out.
+/// </summary>
+/// <param name="name">The ImGui ID of the grid</param>
+/// <param name="fileNames">The image files</param>
+/// <param name="count">The number of files</param>
+/// <param name="thumbnailSize">The size of the grid cells, 0 for the atlas thumbnail size</param>
+/// <param name="selected">The selected index, highlighted and set on click, may be NULL</param>
+/// <returns>The index of the clicked thumbnail, -1 if none was clicked</returns>
+RLIMGUIAPI int rlImGuiThumbnailGrid(const char* name, const char** fileNames, int count, float thumbnailSize, int* selected);
+
+/// <summary>
+/// Draws a small texture from a copy packed into the thumbnail atlas pages, so panels of many small images and icons
+/// share a texture and draw in a handful of draw calls instead of one per image. This is a partial atlas: the font
+/// atlas, larger and compressed textures keep their own textures, so a frame with text and packed images takes
+/// at least two draws. The copy is made on the GPU by the render thread, the texture itself is drawn until it is ready.
+/// Builds without the GL loader (RLIMGUI_NO_GL_LOADER, GL 1.1, 2.1, ES2 or non GLFW platforms) always draw the texture.
+/// </summary>
+/// <param name="image">The texture to draw</param>
+/// <param name="size">The size to draw it at, 0 for the texture size</param>
+RLIMGUIAPI void rlImGuiImagePacked(const Texture* image, Vector2 size);
+
+/// <summary>
+/// Drops the packed copy of a texture. Call it when the texture is updated or before it is unloaded,
+/// drawing it again with rlImGuiImagePacked makes a new copy.
+/// </summary>
+/// <param name="image">The texture</param>
+RLIMGUIAPI void rlImGuiReleasePackedImage(const Texture* image);
+
 #ifdef __cplusplus
 }
 #endif
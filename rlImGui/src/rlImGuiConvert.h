@@ -0,0 +1,194 @@
+/**********************************************************************************************
+*
+*   raylibExtras * Utilities and Shared Components for Raylib
+*
+*   rlImGui * basic ImGui integration
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "imgui.h"
+
+#include <stddef.h>
+#include <string.h>
+
+// Bulk conversion of indexed ImDrawVert data into the de-indexed vertex stream the GPU path draws.
+// The SIMD kernels are picked at runtime from what the CPU supports, define RLIMGUI_NO_SIMD to only use the scalar one.
+
+#if !defined(RLIMGUI_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define RLIMGUI_CONVERT_SSE2
+#include <emmintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RLIMGUI_CONVERT_AVX2
+#define RLIMGUI_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#define RLIMGUI_CONVERT_AVX2
+#define RLIMGUI_TARGET_AVX2
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#endif
+
+namespace rlImGuiConvert
+{
+    template<typename Index>
+    using DeindexKernel = void (*)(ImDrawVert* out, const ImDrawVert* vertices, const Index* indices, unsigned int count);
+
+    // the SIMD kernels move each vertex as 16 bytes of position and uv plus 4 bytes of color
+    constexpr bool PackedLayout = sizeof(ImDrawVert) == 20 &&
+        offsetof(ImDrawVert, pos) == 0 && offsetof(ImDrawVert, uv) == 8 && offsetof(ImDrawVert, col) == 16;
+
+    template<typename Index>
+    inline void DeindexScalar(ImDrawVert* out, const ImDrawVert* vertices, const Index* indices, unsigned int count)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            out[i] = vertices[indices[i]];
+    }
+
+#ifdef RLIMGUI_CONVERT_SSE2
+    // moves one 20 byte vertex as two overlapping 16 byte blocks, bytes 0-15 and 4-19,
+    // so neither the load nor the store touches memory outside the vertex
+    inline void CopyVertex(char* dest, const char* source)
+    {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), head);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 4), tail);
+    }
+
+    template<typename Index>
+    inline void DeindexSSE2(ImDrawVert* out, const ImDrawVert* vertices, const Index* indices, unsigned int count)
+    {
+        const char* source = reinterpret_cast<const char*>(vertices);
+        char* dest = reinterpret_cast<char*>(out);
+
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4, dest += 4 * sizeof(ImDrawVert))
+        {
+            CopyVertex(dest + 0 * sizeof(ImDrawVert), source + indices[i + 0] * sizeof(ImDrawVert));
+            CopyVertex(dest + 1 * sizeof(ImDrawVert), source + indices[i + 1] * sizeof(ImDrawVert));
+            CopyVertex(dest + 2 * sizeof(ImDrawVert), source + indices[i + 2] * sizeof(ImDrawVert));
+            CopyVertex(dest + 3 * sizeof(ImDrawVert), source + indices[i + 3] * sizeof(ImDrawVert));
+        }
+
+        DeindexScalar(out + i, vertices, indices + i, count - i);
+    }
+#endif
+
+#ifdef RLIMGUI_CONVERT_AVX2
+    // 8 vertices per iteration, the byte offsets of the sources are computed 8 at a time
+    template<typename Index>
+    RLIMGUI_TARGET_AVX2 inline void DeindexAVX2(ImDrawVert* out, const ImDrawVert* vertices, const Index* indices, unsigned int count)
+    {
+        const char* source = reinterpret_cast<const char*>(vertices);
+        char* dest = reinterpret_cast<char*>(out);
+
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8, dest += 8 * sizeof(ImDrawVert))
+        {
+            __m256i index;
+            if (sizeof(Index) == 2)
+                index = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)));
+            else
+                index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+
+            // index * 20
+            __m256i offset = _mm256_add_epi32(_mm256_slli_epi32(index, 4), _mm256_slli_epi32(index, 2));
+
+            alignas(32) unsigned int offsets[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(offsets), offset);
+
+            for (int v = 0; v < 8; ++v)
+            {
+                const char* vertex = source + offsets[v];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + v * sizeof(ImDrawVert)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(vertex)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + v * sizeof(ImDrawVert) + 4), _mm_loadu_si128(reinterpret_cast<const __m128i*>(vertex + 4)));
+            }
+        }
+
+        DeindexScalar(out + i, vertices, indices + i, count - i);
+    }
+
+    inline bool CPUHasAVX2()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // the OS must also save the AVX registers
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        // may run from a static initializer, before libgcc initialized the CPU model
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    /// <summary>
+    /// Picks the fastest de-index kernel this CPU supports
+    /// </summary>
+    template<typename Index>
+    inline DeindexKernel<Index> GetDeindexKernel()
+    {
+        if (!PackedLayout)
+            return DeindexScalar<Index>;
+
+#ifdef RLIMGUI_CONVERT_AVX2
+        if (CPUHasAVX2())
+            return DeindexAVX2<Index>;
+#endif
+#ifdef RLIMGUI_CONVERT_SSE2
+        return DeindexSSE2<Index>;
+#else
+        return DeindexScalar<Index>;
+#endif
+    }
+
+    template<typename Index>
+    inline const char* GetDeindexKernelName(DeindexKernel<Index> kernel)
+    {
+#ifdef RLIMGUI_CONVERT_AVX2
+        if (kernel == DeindexAVX2<Index>)
+            return "AVX2";
+#endif
+#ifdef RLIMGUI_CONVERT_SSE2
+        if (kernel == DeindexSSE2<Index>)
+            return "SSE2";
+#endif
+        return "scalar";
+    }
+}
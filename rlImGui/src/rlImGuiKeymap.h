@@ -0,0 +1,228 @@
+/**********************************************************************************************
+*
+*   raylibExtras * Utilities and Shared Components for Raylib
+*
+*   rlImGui * basic ImGui integration
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+#include "imgui.h"
+
+// Translation of raylib keyboard state into ImGui key events.
+// The mapping is a constant table indexed by raylib key, and key releases are only polled for keys that went down.
+
+namespace rlImGuiKeymap
+{
+    struct KeyMapping
+    {
+        KeyboardKey RaylibKey;
+        ImGuiKey Key;
+    };
+
+    // every raylib key ImGui has a key for
+    constexpr KeyMapping Mappings[] =
+    {
+        { KEY_APOSTROPHE, ImGuiKey_Apostrophe },
+        { KEY_COMMA, ImGuiKey_Comma },
+        { KEY_MINUS, ImGuiKey_Minus },
+        { KEY_PERIOD, ImGuiKey_Period },
+        { KEY_SLASH, ImGuiKey_Slash },
+        { KEY_ZERO, ImGuiKey_0 },
+        { KEY_ONE, ImGuiKey_1 },
+        { KEY_TWO, ImGuiKey_2 },
+        { KEY_THREE, ImGuiKey_3 },
+        { KEY_FOUR, ImGuiKey_4 },
+        { KEY_FIVE, ImGuiKey_5 },
+        { KEY_SIX, ImGuiKey_6 },
+        { KEY_SEVEN, ImGuiKey_7 },
+        { KEY_EIGHT, ImGuiKey_8 },
+        { KEY_NINE, ImGuiKey_9 },
+        { KEY_SEMICOLON, ImGuiKey_Semicolon },
+        { KEY_EQUAL, ImGuiKey_Equal },
+        { KEY_A, ImGuiKey_A },
+        { KEY_B, ImGuiKey_B },
+        { KEY_C, ImGuiKey_C },
+        { KEY_D, ImGuiKey_D },
+        { KEY_E, ImGuiKey_E },
+        { KEY_F, ImGuiKey_F },
+        { KEY_G, ImGuiKey_G },
+        { KEY_H, ImGuiKey_H },
+        { KEY_I, ImGuiKey_I },
+        { KEY_J, ImGuiKey_J },
+        { KEY_K, ImGuiKey_K },
+        { KEY_L, ImGuiKey_L },
+        { KEY_M, ImGuiKey_M },
+        { KEY_N, ImGuiKey_N },
+        { KEY_O, ImGuiKey_O },
+        { KEY_P, ImGuiKey_P },
+        { KEY_Q, ImGuiKey_Q },
+        { KEY_R, ImGuiKey_R },
+        { KEY_S, ImGuiKey_S },
+        { KEY_T, ImGuiKey_T },
+        { KEY_U, ImGuiKey_U },
+        { KEY_V, ImGuiKey_V },
+        { KEY_W, ImGuiKey_W },
+        { KEY_X, ImGuiKey_X },
+        { KEY_Y, ImGuiKey_Y },
+        { KEY_Z, ImGuiKey_Z },
+        { KEY_SPACE, ImGuiKey_Space },
+        { KEY_ESCAPE, ImGuiKey_Escape },
+        { KEY_ENTER, ImGuiKey_Enter },
+        { KEY_TAB, ImGuiKey_Tab },
+        { KEY_BACKSPACE, ImGuiKey_Backspace },
+        { KEY_INSERT, ImGuiKey_Insert },
+        { KEY_DELETE, ImGuiKey_Delete },
+        { KEY_RIGHT, ImGuiKey_RightArrow },
+        { KEY_LEFT, ImGuiKey_LeftArrow },
+        { KEY_DOWN, ImGuiKey_DownArrow },
+        { KEY_UP, ImGuiKey_UpArrow },
+        { KEY_PAGE_UP, ImGuiKey_PageUp },
+        { KEY_PAGE_DOWN, ImGuiKey_PageDown },
+        { KEY_HOME, ImGuiKey_Home },
+        { KEY_END, ImGuiKey_End },
+        { KEY_CAPS_LOCK, ImGuiKey_CapsLock },
+        { KEY_SCROLL_LOCK, ImGuiKey_ScrollLock },
+        { KEY_NUM_LOCK, ImGuiKey_NumLock },
+        { KEY_PRINT_SCREEN, ImGuiKey_PrintScreen },
+        { KEY_PAUSE, ImGuiKey_Pause },
+        { KEY_F1, ImGuiKey_F1 },
+        { KEY_F2, ImGuiKey_F2 },
+        { KEY_F3, ImGuiKey_F3 },
+        { KEY_F4, ImGuiKey_F4 },
+        { KEY_F5, ImGuiKey_F5 },
+        { KEY_F6, ImGuiKey_F6 },
+        { KEY_F7, ImGuiKey_F7 },
+        { KEY_F8, ImGuiKey_F8 },
+        { KEY_F9, ImGuiKey_F9 },
+        { KEY_F10, ImGuiKey_F10 },
+        { KEY_F11, ImGuiKey_F11 },
+        { KEY_F12, ImGuiKey_F12 },
+        { KEY_LEFT_SHIFT, ImGuiKey_LeftShift },
+        { KEY_LEFT_CONTROL, ImGuiKey_LeftCtrl },
+        { KEY_LEFT_ALT, ImGuiKey_LeftAlt },
+        { KEY_LEFT_SUPER, ImGuiKey_LeftSuper },
+        { KEY_RIGHT_SHIFT, ImGuiKey_RightShift },
+        { KEY_RIGHT_CONTROL, ImGuiKey_RightCtrl },
+        { KEY_RIGHT_ALT, ImGuiKey_RightAlt },
+        { KEY_RIGHT_SUPER, ImGuiKey_RightSuper },
+        { KEY_KB_MENU, ImGuiKey_Menu },
+        { KEY_LEFT_BRACKET, ImGuiKey_LeftBracket },
+        { KEY_BACKSLASH, ImGuiKey_Backslash },
+        { KEY_RIGHT_BRACKET, ImGuiKey_RightBracket },
+        { KEY_GRAVE, ImGuiKey_GraveAccent },
+        { KEY_KP_0, ImGuiKey_Keypad0 },
+        { KEY_KP_1, ImGuiKey_Keypad1 },
+        { KEY_KP_2, ImGuiKey_Keypad2 },
+        { KEY_KP_3, ImGuiKey_Keypad3 },
+        { KEY_KP_4, ImGuiKey_Keypad4 },
+        { KEY_KP_5, ImGuiKey_Keypad5 },
+        { KEY_KP_6, ImGuiKey_Keypad6 },
+        { KEY_KP_7, ImGuiKey_Keypad7 },
+        { KEY_KP_8, ImGuiKey_Keypad8 },
+        { KEY_KP_9, ImGuiKey_Keypad9 },
+        { KEY_KP_DECIMAL, ImGuiKey_KeypadDecimal },
+        { KEY_KP_DIVIDE, ImGuiKey_KeypadDivide },
+        { KEY_KP_MULTIPLY, ImGuiKey_KeypadMultiply },
+        { KEY_KP_SUBTRACT, ImGuiKey_KeypadSubtract },
+        { KEY_KP_ADD, ImGuiKey_KeypadAdd },
+        { KEY_KP_ENTER, ImGuiKey_KeypadEnter },
+        { KEY_KP_EQUAL, ImGuiKey_KeypadEqual },
+    };
+
+    // KEY_KB_MENU is the highest raylib keyboard key
+    constexpr int TableSize = KEY_KB_MENU + 1;
+
+    struct KeyTable
+    {
+        ImGuiKey Keys[TableSize] = {};
+    };
+
+    constexpr KeyTable BuildKeyTable()
+    {
+        KeyTable table;
+        for (const KeyMapping& mapping : Mappings)
+            table.Keys[mapping.RaylibKey] = mapping.Key;
+        return table;
+    }
+
+    constexpr KeyTable Table = BuildKeyTable();
+
+    constexpr ImGuiKey ToImGuiKey(int key)
+    {
+        return (key > 0 && key < TableSize) ? Table.Keys[key] : ImGuiKey_None;
+    }
+
+    /// <summary>
+    /// Sends ImGui the keys that changed since the last call through addKeyEvent(ImGuiKey, bool down).
+    /// Keyboard provides IsKeyUp, IsKeyPressed and GetKeyPressed with raylib's behavior.
+    /// When useQueue is set the presses are read from raylib's key queue, consuming it, instead of polling every mapped key.
+    /// </summary>
+    template<typename Keyboard, typename AddKeyEvent>
+    inline void TranslateKeyEvents(ImVector<int>& heldKeys, bool useQueue, AddKeyEvent addKeyEvent)
+    {
+        // only a key that went down can come up
+        for (int i = 0; i < heldKeys.Size;)
+        {
+            if (Keyboard::IsKeyUp(heldKeys[i]))
+            {
+                addKeyEvent(ToImGuiKey(heldKeys[i]), false);
+                heldKeys[i] = heldKeys.back();
+                heldKeys.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        auto keyDown = [&heldKeys, &addKeyEvent](int key)
+        {
+            ImGuiKey imGuiKey = ToImGuiKey(key);
+            if (imGuiKey == ImGuiKey_None)
+                return;
+
+            if (!heldKeys.contains(key))
+                heldKeys.push_back(key);
+            addKeyEvent(imGuiKey, true);
+        };
+
+        if (useQueue)
+        {
+            for (int key = Keyboard::GetKeyPressed(); key != 0; key = Keyboard::GetKeyPressed())
+                keyDown(key);
+        }
+        else
+        {
+            for (const KeyMapping& mapping : Mappings)
+            {
+                if (Keyboard::IsKeyPressed(mapping.RaylibKey))
+                    keyDown(mapping.RaylibKey);
+            }
+        }
+    }
+}